@@ -0,0 +1,270 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <tbb/task_arena.h>
+
+#include <openvino/op/constant.hpp>
+#include <openvino/op/parameter.hpp>
+
+#include "calculate_grid.hpp"
+#include "complex_mul.hpp"
+#include "fft.hpp"
+#include "fft_convolution.hpp"
+#include "grid_sample.hpp"
+#include "reduced_precision.hpp"
+#include "sparse_conv.hpp"
+#include "sparse_conv_transpose.hpp"
+
+using namespace TemplateExtension;
+
+namespace {
+
+// Every benchmark runs single threaded and with all the hardware threads
+std::vector<int64_t> getThreadCounts() {
+    const int64_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    return maxThreads > 1 ? std::vector<int64_t>{1, maxThreads} : std::vector<int64_t>{1};
+}
+
+// Registers every combination of argument lists with every thread count. The thread count is the last argument.
+// Work is done by threads of an arena, so wall time is measured instead of CPU time of the main thread.
+void applyWithThreads(benchmark::internal::Benchmark* b, const std::vector<std::vector<int64_t>>& argsList) {
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+    for (const auto& args : argsList) {
+        for (int64_t threads : getThreadCounts()) {
+            std::vector<int64_t> withThreads = args;
+            withThreads.push_back(threads);
+            b->Args(withThreads);
+        }
+    }
+}
+
+// Floating point element type argument: 0 - f32, 1 - f16, 2 - bf16
+ov::element::Type floatType(int64_t index) {
+    static const ov::element::Type types[] = {ov::element::f32, ov::element::f16, ov::element::bf16};
+    return types[index];
+}
+
+ov::Tensor randomTensor(const ov::Shape& shape, float low, float high,
+                        const ov::element::Type& type = ov::element::f32) {
+    static std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(ov::shape_size(shape));
+    for (float& value : values)
+        value = dist(gen);
+    ov::Tensor tensor(type, shape);
+    if (type == ov::element::f16)
+        convertFromFloat(values.data(), tensor.data<ov::float16>(), values.size());
+    else if (type == ov::element::bf16)
+        convertFromFloat(values.data(), tensor.data<ov::bfloat16>(), values.size());
+    else
+        std::copy(values.begin(), values.end(), tensor.data<float>());
+    return tensor;
+}
+
+// Random u8 or i8 values
+ov::Tensor randomInt8Tensor(const ov::Shape& shape, const ov::element::Type& type) {
+    static std::mt19937 gen(42);
+    ov::Tensor tensor(type, shape);
+    uint8_t* data = static_cast<uint8_t*>(tensor.data());
+    for (size_t i = 0; i < tensor.get_size(); ++i)
+        data[i] = static_cast<uint8_t>(gen());
+    return tensor;
+}
+
+ov::Tensor zeroTensor(const ov::Shape& shape) {
+    ov::Tensor tensor(ov::element::f32, shape);
+    std::fill_n(tensor.data<float>(), tensor.get_size(), 0.0f);
+    return tensor;
+}
+
+ov::Tensor constantTensor(const std::shared_ptr<ov::op::v0::Constant>& constant) {
+    ov::Tensor tensor(constant->get_element_type(), constant->get_shape());
+    std::copy_n(static_cast<const char*>(constant->get_data_ptr()), tensor.get_byte_size(),
+                static_cast<char*>(tensor.data()));
+    return tensor;
+}
+
+std::shared_ptr<ov::op::v0::Parameter> parameter(const ov::Shape& shape,
+                                                 const ov::element::Type& type = ov::element::f32) {
+    return std::make_shared<ov::op::v0::Parameter>(type, shape);
+}
+
+std::shared_ptr<ov::op::v0::Constant> signalDimsConstant(const std::vector<int32_t>& dims) {
+    return std::make_shared<ov::op::v0::Constant>(ov::element::i32, ov::Shape{dims.size()}, dims);
+}
+
+// Centers of unique voxels of a cube. Occupancy of about 10% is close to surfaces scanned by LiDARs.
+ov::Tensor voxelPositions(size_t numPoints) {
+    static std::mt19937 gen(7);
+    const size_t ext = static_cast<size_t>(std::ceil(std::cbrt(10.0 * numPoints)));
+    std::vector<size_t> cells(ext * ext * ext);
+    std::iota(cells.begin(), cells.end(), 0);
+    ov::Tensor tensor(ov::element::f32, {numPoints, 3});
+    float* data = tensor.data<float>();
+    for (size_t i = 0; i < numPoints; ++i) {
+        std::swap(cells[i], cells[i + gen() % (cells.size() - i)]);
+        data[i * 3] = 0.5f + cells[i] % ext;
+        data[i * 3 + 1] = 0.5f + (cells[i] / ext) % ext;
+        data[i * 3 + 2] = 0.5f + cells[i] / (ext * ext);
+    }
+    return tensor;
+}
+
+// Runs evaluate() of a node with static shapes in an arena of the given number of threads
+void runOp(benchmark::State& state, const std::shared_ptr<ov::Node>& op, const ov::TensorVector& inputs,
+           int threads) {
+    ov::TensorVector outputs{ov::Tensor(op->get_output_element_type(0), op->get_output_shape(0))};
+    tbb::task_arena arena(threads);
+    arena.execute([&] {
+        for (auto _ : state) {
+            op->evaluate(outputs, inputs);
+            benchmark::ClobberMemory();
+        }
+    });
+
+    size_t bytes = outputs[0].get_byte_size();
+    for (const auto& input : inputs)
+        bytes += input.get_byte_size();
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.counters["threads"] = threads;
+}
+
+// Args: batch, height, width, number of signal dimensions (1 - width, 2 - height and width), inverse,
+// element type, threads
+void BM_FFT(benchmark::State& state) {
+    const size_t batch = state.range(0), height = state.range(1), width = state.range(2);
+    const std::vector<int32_t> dims = state.range(3) == 1 ? std::vector<int32_t>{2} : std::vector<int32_t>{1, 2};
+    const ov::Shape shape{batch, height, width, 2};
+    const ov::element::Type type = floatType(state.range(5));
+    auto signalDims = signalDimsConstant(dims);
+    auto op = std::make_shared<FFT>(ov::OutputVector{parameter(shape, type), signalDims}, state.range(4) != 0, false);
+    runOp(state, op, {randomTensor(shape, -1, 1, type), constantTensor(signalDims)}, state.range(6));
+}
+BENCHMARK(BM_FFT)->Apply([](benchmark::internal::Benchmark* b) {
+    // Powers of two, mixed radices of MRI k-spaces and a prime size which requires Bluestein's algorithm
+    applyWithThreads(b, {{16, 256, 256, 2, 0, 0}, {16, 256, 256, 2, 1, 0}, {16, 320, 320, 2, 0, 0},
+                         {4, 640, 368, 2, 0, 0}, {256, 1, 4096, 1, 0, 0}, {256, 1, 1009, 1, 0, 0},
+                         {16, 256, 256, 2, 0, 1}, {16, 256, 256, 2, 0, 2}});
+});
+
+// Args: batch, height, width, threads
+void BM_RFFT(benchmark::State& state) {
+    const ov::Shape shape{static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)),
+                          static_cast<size_t>(state.range(2))};
+    auto signalDims = signalDimsConstant({1, 2});
+    auto op = std::make_shared<FFT>(ov::OutputVector{parameter(shape), signalDims}, false, false, true);
+    runOp(state, op, {randomTensor(shape, -1, 1), constantTensor(signalDims)}, state.range(3));
+}
+BENCHMARK(BM_RFFT)->Apply([](benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{16, 256, 256}, {4, 640, 368}});
+});
+
+// Args: batch, height, width, filter is shared by the batch, threads
+void BM_FFTConvolution(benchmark::State& state) {
+    const size_t batch = state.range(0), height = state.range(1), width = state.range(2);
+    const ov::Shape shape{batch, height, width, 2};
+    const ov::Shape filterShape{state.range(3) ? 1 : batch, height, width, 2};
+    auto signalDims = signalDimsConstant({1, 2});
+    auto op = std::make_shared<FFTConvolution>(ov::OutputVector{parameter(shape), parameter(filterShape), signalDims},
+                                               false);
+    runOp(state, op, {randomTensor(shape, -1, 1), randomTensor(filterShape, -1, 1), constantTensor(signalDims)},
+          state.range(4));
+}
+BENCHMARK(BM_FFTConvolution)->Apply([](benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{16, 256, 256, 1}, {16, 256, 256, 0}, {4, 640, 368, 1}});
+});
+
+// Args: number of complex elements, the second input is broadcasted along the outer dimension, element type,
+// threads
+void BM_ComplexMultiplication(benchmark::State& state) {
+    const size_t rowSize = 4096;
+    const ov::Shape shape{static_cast<size_t>(state.range(0)) / rowSize, rowSize, 2};
+    const ov::Shape otherShape = state.range(1) ? ov::Shape{1, rowSize, 2} : shape;
+    const ov::element::Type type = floatType(state.range(2));
+    auto op = std::make_shared<ComplexMultiplication>(
+        ov::OutputVector{parameter(shape, type), parameter(otherShape, type)});
+    runOp(state, op, {randomTensor(shape, -1, 1, type), randomTensor(otherShape, -1, 1, type)}, state.range(3));
+}
+BENCHMARK(BM_ComplexMultiplication)->Apply([](benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{1 << 16, 0, 0}, {1 << 22, 0, 0}, {1 << 22, 1, 0}, {1 << 22, 0, 1}, {1 << 22, 0, 2}});
+});
+
+// Args: channels, input size, output size, mode (0 - nearest, 1 - bilinear, 2 - bicubic), constant grid,
+// element type of the input and the grid, threads
+void BM_GridSample(benchmark::State& state) {
+    static const char* modes[] = {"nearest", "bilinear", "bicubic"};
+    const size_t channels = state.range(0), inpSize = state.range(1), outSize = state.range(2);
+    const ov::Shape shape{1, channels, inpSize, inpSize};
+    const ov::Shape gridShape{1, outSize, outSize, 2};
+    const ov::element::Type type = floatType(state.range(5));
+    // Some of the points are outside of the input
+    const ov::Tensor grid = randomTensor(gridShape, -1.1f, 1.1f, type);
+    std::shared_ptr<ov::Node> gridNode = parameter(gridShape, type);
+    if (state.range(4))
+        gridNode = std::make_shared<ov::op::v0::Constant>(grid);
+    auto op = std::make_shared<GridSample>(ov::OutputVector{parameter(shape, type), gridNode}, modes[state.range(3)]);
+    runOp(state, op, {randomTensor(shape, -1, 1, type), grid}, state.range(6));
+}
+BENCHMARK(BM_GridSample)->Apply([](benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{3, 256, 256, 1, 0, 0}, {64, 128, 128, 1, 0, 0}, {64, 128, 128, 1, 1, 0},
+                         {64, 128, 128, 0, 0, 0}, {64, 128, 128, 2, 0, 0}, {3, 1024, 512, 1, 0, 0},
+                         {3, 1024, 512, 1, 0, 2}, {64, 128, 128, 1, 0, 2}});
+});
+
+// Args: number of points, input channels, output channels, threads
+template <typename Op>
+void BM_SparseConvolution(benchmark::State& state) {
+    const size_t numPoints = state.range(0), IC = state.range(1), OC = state.range(2);
+    const ov::Shape featuresShape{numPoints, IC}, posShape{numPoints, 3}, kernelShape{3, 3, 3, IC, OC};
+    // Submanifold convolution: output points are the input ones
+    const ov::Tensor pos = voxelPositions(numPoints);
+    auto op = std::make_shared<Op>(ov::OutputVector{parameter(featuresShape), parameter(posShape),
+                                                    parameter(posShape), parameter(kernelShape),
+                                                    parameter({3})});
+    runOp(state, op, {randomTensor(featuresShape, -1, 1), pos, pos, randomTensor(kernelShape, -1, 1),
+                      zeroTensor({3})}, state.range(3));
+}
+void applySparseConvolution(benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{10000, 4, 8}, {10000, 32, 32}, {100000, 8, 16}, {100000, 64, 64}});
+}
+BENCHMARK_TEMPLATE(BM_SparseConvolution, SparseConv)->Apply(applySparseConvolution);
+BENCHMARK_TEMPLATE(BM_SparseConvolution, SparseConvTranspose)->Apply(applySparseConvolution);
+
+// Args: number of points, input channels, output channels, threads. u8 features and an i8 kernel.
+template <typename Op>
+void BM_SparseConvolutionInt8(benchmark::State& state) {
+    const size_t numPoints = state.range(0), IC = state.range(1), OC = state.range(2);
+    const ov::Shape featuresShape{numPoints, IC}, posShape{numPoints, 3}, kernelShape{3, 3, 3, IC, OC};
+    const ov::Tensor pos = voxelPositions(numPoints);
+    auto op = std::make_shared<Op>(ov::OutputVector{parameter(featuresShape, ov::element::u8), parameter(posShape),
+                                                    parameter(posShape), parameter(kernelShape, ov::element::i8),
+                                                    parameter({3}), parameter({OC})});
+    runOp(state, op, {randomInt8Tensor(featuresShape, ov::element::u8), pos, pos,
+                      randomInt8Tensor(kernelShape, ov::element::i8), zeroTensor({3}), randomTensor({OC}, 0, 1e-3f)},
+          state.range(3));
+}
+BENCHMARK_TEMPLATE(BM_SparseConvolutionInt8, SparseConv)->Apply(applySparseConvolution);
+
+// Args: number of points, extent of the point cloud, threads
+void BM_CalculateGrid(benchmark::State& state) {
+    const size_t numPoints = state.range(0);
+    const ov::Shape shape{numPoints, 3};
+    auto op = std::make_shared<CalculateGrid>(parameter(shape));
+    runOp(state, op, {randomTensor(shape, 0, static_cast<float>(state.range(1)))}, state.range(2));
+}
+BENCHMARK(BM_CalculateGrid)->Apply([](benchmark::internal::Benchmark* b) {
+    applyWithThreads(b, {{100000, 100}, {1000000, 100}, {1000000, 1000}});
+});
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,121 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import argparse
+import collections
+import struct
+import numpy as np
+import onnx
+from onnx import helper, numpy_helper, TensorProto
+
+
+def pack_strings(strings, packed_format='offsets32'):
+    # Packed string tensor: int32 batch size, int32 begin offset, int32 end offsets and symbols.
+    # offsets64 layout starts with int32 marker -1 and int32 version 2, and its batch size and offsets are uint64.
+    data = [s.encode('utf-8') for s in strings]
+    offsets = np.cumsum([0] + [len(s) for s in data])
+    if packed_format == 'offsets64':
+        header = struct.pack('<iiQ', -1, 2, len(data)) + offsets.astype(np.uint64).tobytes()
+    else:
+        header = struct.pack('<i', len(data)) + offsets.astype(np.int32).tobytes()
+    return np.frombuffer(header + b''.join(data), dtype=np.uint8).copy()
+
+
+def train_bpe(texts, num_merges, suffix):
+    # Toy trainer which merges the most frequent pair of every step
+    words = collections.Counter(w for text in texts for w in text.split())
+    splits = {w: list(w[:-1]) + [w[-1] + suffix] for w in words}
+    vocab = sorted(set(s for split in splits.values() for s in split))
+    merges = []
+    for _ in range(num_merges):
+        pairs = collections.Counter()
+        for w, split in splits.items():
+            for pair in zip(split, split[1:]):
+                pairs[pair] += words[w]
+        if not pairs:
+            break
+        best = max(pairs, key=lambda p: (pairs[p], p))
+        merges.append(best)
+        vocab.append(best[0] + best[1])
+        for w, split in splits.items():
+            i = 0
+            while i + 1 < len(split):
+                if (split[i], split[i + 1]) == best:
+                    split[i:i + 2] = [best[0] + best[1]]
+                i += 1
+    return vocab, merges
+
+
+def tokenize(texts, vocab, merges, max_length, pad_token_id, unk_token_id, suffix):
+    ids = {t: i for i, t in reversed(list(enumerate(vocab)))}
+    ranks = {pair: i for i, pair in reversed(list(enumerate(merges)))}
+    result = []
+    for text in texts:
+        seq = []
+        for w in text.split():
+            symbols = list(w[:-1]) + [w[-1] + suffix]
+            while len(symbols) > 1:
+                pairs = [(ranks.get(p, len(ranks)), i) for i, p in enumerate(zip(symbols, symbols[1:]))
+                         if p in ranks and p[0] + p[1] in ids]
+                if not pairs:
+                    break
+                _, i = min(pairs)
+                symbols[i:i + 2] = [symbols[i] + symbols[i + 1]]
+            seq += [ids[s] if s in ids else unk_token_id for s in symbols if s in ids or unk_token_id >= 0]
+        result.append(seq)
+
+    length = max_length if max_length > 0 else max([len(seq) for seq in result] + [0])
+    input_ids = np.full([len(texts), length], pad_token_id, dtype=np.int64)
+    attention_mask = np.zeros([len(texts), length], dtype=np.int64)
+    for b, seq in enumerate(result):
+        seq = seq[:length]
+        input_ids[b, :len(seq)] = seq
+        attention_mask[b, :len(seq)] = 1
+    return input_ids, attention_mask
+
+
+def export(texts, corpus=None, num_merges=50, max_length=0, pad_token_id=0, unk_token_id=-1, suffix='</w>',
+           packed_format='offsets32'):
+    vocab, merges = train_bpe(corpus or texts, num_merges, suffix)
+    packed_vocab = pack_strings(vocab, packed_format)
+    packed_merges = pack_strings([left + ' ' + right for left, right in merges], packed_format)
+
+    node = helper.make_node('BPETokenizer', ['input', 'vocab', 'merges'], ['input_ids', 'attention_mask'],
+                            max_length=max_length, pad_token_id=pad_token_id, unk_token_id=unk_token_id,
+                            end_of_word_suffix=suffix)
+    graph = helper.make_graph(
+        [node], 'bpe_tokenizer',
+        [helper.make_tensor_value_info('input', TensorProto.UINT8, [None])],
+        [helper.make_tensor_value_info('input_ids', TensorProto.INT64, [None, None]),
+         helper.make_tensor_value_info('attention_mask', TensorProto.INT64, [None, None])],
+        [numpy_helper.from_array(packed_vocab, 'vocab'), numpy_helper.from_array(packed_merges, 'merges')])
+    onnx.save(helper.make_model(graph), 'model.onnx')
+
+    input_ids, _ = tokenize(texts, vocab, merges, max_length, pad_token_id, unk_token_id, suffix)
+    return [pack_strings(texts, packed_format)], input_ids
+
+
+def export_detokenizer(texts, corpus=None, num_merges=50, suffix='</w>'):
+    # Tokens of every word are decoded back, so the corpus must contain all the symbols of the texts
+    vocab, merges = train_bpe(corpus or texts, num_merges, suffix)
+    input_ids, _ = tokenize(texts, vocab, merges, 0, -1, -1, suffix)
+
+    node = helper.make_node('Detokenizer', ['input', 'vocab'], ['output'], end_of_word_suffix=suffix)
+    graph = helper.make_graph(
+        [node], 'detokenizer',
+        [helper.make_tensor_value_info('input', TensorProto.INT64, [None, None])],
+        [helper.make_tensor_value_info('output', TensorProto.UINT8, [None])],
+        [numpy_helper.from_array(pack_strings(vocab), 'vocab')])
+    onnx.save(helper.make_model(graph), 'model.onnx')
+
+    separator = ' ' if suffix else ''
+    return [input_ids], pack_strings([separator.join(text.split()) for text in texts])
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--texts', nargs='+', default=['low lower lowest', 'newer wider', ''])
+    parser.add_argument('--max_length', type=int, default=0)
+    parser.add_argument('--packed_format', default='offsets32', choices=['offsets32', 'offsets64'])
+    args = parser.parse_args()
+    export(args.texts, max_length=args.max_length, packed_format=args.packed_format)
@@ -5,13 +5,32 @@ import torch
 import torch.nn as nn
 import torch.nn.functional as F
 
+def morton_key(voxels):
+    # Interleaves 21 bits of every coordinate, bits of x are the most significant ones
+    key = torch.zeros(voxels.shape[0], dtype=torch.int64)
+    for bit in range(21):
+        for k in range(3):
+            key |= ((voxels[:, k] >> bit) & 1) << (3 * bit + 2 - k)
+    return key
+
+
 class CalculateGrid(torch.autograd.Function):
     @staticmethod
-    def symbolic(g, in_positions):
-        return g.op("CalculateGrid", in_positions)
+    def symbolic(g, in_positions, row_splits=None, order='lexicographic'):
+        attrs = {} if order == 'lexicographic' else {'order_s': order}
+        if row_splits is None:
+            return g.op("CalculateGrid", in_positions, **attrs)
+        return g.op("CalculateGrid", in_positions, row_splits, outputs=2, **attrs)
 
     @staticmethod
-    def forward(self, in_positions):
+    def forward(self, in_positions, row_splits=None, order='lexicographic'):
+        if row_splits is not None:
+            # Every cloud of a batch is processed separately
+            clouds = [CalculateGrid.forward(self, in_positions[a:b], None, order)
+                      for a, b in zip(row_splits[:-1], row_splits[1:])]
+            out_splits = torch.tensor([0] + [cloud.shape[0] for cloud in clouds]).cumsum(0).to(row_splits.dtype)
+            return torch.cat(clouds), out_splits
+
         filter = torch.Tensor([[-1, -1, -1], [-1, -1, 0], [-1, 0, -1], [-1, 0, 0],
                                [0, -1, -1], [0, -1, 0], [0, 0, -1],
                                [0, 0, 0]]).to(in_positions.device)
@@ -23,5 +42,7 @@ class CalculateGrid(torch.autograd.Function):
         out_pos = out_pos[out_pos.min(1).values >= 0]
         out_pos = out_pos[(~((out_pos.long() % 2).bool()).any(1))]
         out_pos = torch.unique(out_pos, dim=0)
+        if order == 'morton':
+            out_pos = out_pos[torch.argsort(morton_key(out_pos // 2))]
 
         return out_pos + 0.5
@@ -10,23 +10,37 @@ from .calculate_grid import CalculateGrid
 
 
 class MyModel(nn.Module):
-    def __init__(self):
+    def __init__(self, order='lexicographic'):
         super(MyModel, self).__init__()
         self.calculate_grid = CalculateGrid()
+        self.order = order
 
-    def forward(self, x):
-        return self.calculate_grid.apply(x)
+    def forward(self, x, row_splits=None):
+        return self.calculate_grid.apply(x, row_splits, self.order)
 
 
-def export(num_points, max_grid_extent):
+def export(num_points, max_grid_extent, num_clouds=None, order='lexicographic', origin=0):
     # Generate a list of unique positions and add a mantissa
     np.random.seed(32)
     torch.manual_seed(11)
 
-    inp_pos = np.random.randint(0, max_grid_extent, [num_points, 3])
+    inp_pos = np.random.randint(origin, origin + max_grid_extent, [num_points, 3])
     inp_pos = torch.tensor(inp_pos) + torch.rand(inp_pos.shape, dtype=torch.float32) # [0, 1)
 
-    model = MyModel()
+    model = MyModel(order)
+    if num_clouds:
+        # Clouds of a batch are split by row splits of random sizes
+        sizes = np.random.multinomial(num_points, [1.0 / num_clouds] * num_clouds)
+        row_splits = torch.tensor(np.cumsum(np.concatenate([[0], sizes])), dtype=torch.int64)
+        with torch.no_grad():
+            torch.onnx.export(model, (inp_pos, row_splits), 'model.onnx',
+                              input_names=['input', 'input1'],
+                              output_names=['output', 'output_row_splits'],
+                              operator_export_type=torch.onnx.OperatorExportTypes.ONNX_ATEN_FALLBACK)
+
+        ref, _ = model(inp_pos, row_splits)
+        return [inp_pos.detach().numpy(), row_splits.numpy()], ref.detach().numpy()
+
     with torch.no_grad():
         torch.onnx.export(model, (inp_pos), 'model.onnx',
                           input_names=['input'],
@@ -46,6 +60,9 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
     parser.add_argument('--num_points', type=int, default=10)
     parser.add_argument('--max_grid_extent', type=int, default=5)
+    parser.add_argument('--num_clouds', type=int)
+    parser.add_argument('--order', default='lexicographic', choices=['lexicographic', 'morton'])
+    parser.add_argument('--origin', type=int, default=0)
     args = parser.parse_args()
 
-    export(args.num_points, args.max_grid_extent)
+    export(args.num_points, args.max_grid_extent, args.num_clouds, args.order, args.origin)
@@ -10,22 +10,23 @@ from .fft import FFT
 
 
 class MyModel(nn.Module):
-    def __init__(self, inverse, centered, dims):
+    def __init__(self, inverse, centered, dims, real_input):
         super(MyModel, self).__init__()
         self.inverse = inverse
         self.centered = centered
         self.dims = dims
+        self.real_input = real_input
         self.fft = FFT()
 
     def forward(self, x):
-        return self.fft.apply(x, self.inverse, self.centered, self.dims)
+        return self.fft.apply(x, self.inverse, self.centered, self.dims, self.real_input)
 
 
-def export(shape, inverse, centered, dims):
+def export(shape, inverse, centered, dims, real_input=False):
     np.random.seed(324)
     torch.manual_seed(32)
 
-    model = MyModel(inverse, centered, dims)
+    model = MyModel(inverse, centered, dims, real_input)
     inp = Variable(torch.randn(shape))
     model.eval()
 
@@ -45,5 +46,6 @@ if __name__ == '__main__':
     parser.add_argument('--inverse', action='store_true')
     parser.add_argument('--centered', action='store_true')
     parser.add_argument('--dims', type=int, nargs='+', default=[2, 3])
+    parser.add_argument('--real_input', action='store_true')
     args = parser.parse_args()
-    export(args.shape, args.inverse, args.centered, args.dims)
+    export(args.shape, args.inverse, args.centered, args.dims, args.real_input)
@@ -47,15 +47,20 @@ def ifftshift(data: torch.Tensor, dims) -> torch.Tensor:
 
 class FFT(torch.autograd.Function):
     @staticmethod
-    def symbolic(g, x, inverse, centered, dims):
+    def symbolic(g, x, inverse, centered, dims, real_input=False):
         dims = torch.tensor(dims)
         dims = g.op("Constant", value_t=dims)
 
-        return g.op('FFT', x, dims, inverse_i=inverse, centered_i=centered)
+        return g.op('FFT', x, dims, inverse_i=inverse, centered_i=centered, real_input_i=real_input)
 
     @staticmethod
-    def forward(self, x, inverse, centered, dims):
+    def forward(self, x, inverse, centered, dims, real_input=False):
         # https://pytorch.org/docs/stable/torch.html#torch.fft
+        if real_input:
+            if inverse:
+                return torch.fft.irfftn(torch.view_as_complex(x), dim=dims, norm="ortho")
+            return torch.view_as_real(torch.fft.rfftn(x, dim=dims, norm="ortho"))
+
         if centered:
             x = ifftshift(x, dims)
 
@@ -0,0 +1,54 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import argparse
+import torch
+import torch.nn as nn
+from torch.autograd import Variable
+from ..fft.fft import FFT
+from ..complex_mul.complex_mul import ComplexMul
+
+
+class MyModel(nn.Module):
+    def __init__(self, centered, dims):
+        super(MyModel, self).__init__()
+        self.centered = centered
+        self.dims = dims
+        self.fft = FFT()
+        self.complex_mul = ComplexMul()
+
+    def forward(self, x, h):
+        # FFT -> ComplexMultiplication -> inverse FFT is fused into a single FFTConvolution operation
+        y = self.fft.apply(x, False, self.centered, self.dims)
+        y = self.complex_mul.apply(y, h)
+        return self.fft.apply(y, True, self.centered, self.dims)
+
+
+def export(shape, filter_shape, centered, dims):
+    np.random.seed(324)
+    torch.manual_seed(32)
+
+    model = MyModel(centered, dims)
+    inp = Variable(torch.randn(shape))
+    inp1 = Variable(torch.randn(filter_shape))
+    model.eval()
+
+    with torch.no_grad():
+        torch.onnx.export(model, (inp, inp1), 'model.onnx',
+                          input_names=['input', 'input1'],
+                          output_names=['output'],
+                          operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
+
+    ref = model(inp, inp1)
+    return [inp.detach().numpy(), inp1.detach().numpy()], ref.detach().numpy()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--shape', type=int, nargs='+', default=[3, 2, 4, 8, 2])
+    parser.add_argument('--filter_shape', type=int, nargs='+', default=[3, 1, 4, 8, 2])
+    parser.add_argument('--centered', action='store_true')
+    parser.add_argument('--dims', type=int, nargs='+', default=[2, 3])
+    args = parser.parse_args()
+    export(args.shape, args.filter_shape, args.centered, args.dims)
@@ -0,0 +1,66 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import numpy as np
+import argparse
+import torch
+import torch.nn as nn
+from torch.autograd import Variable
+from .grid_sample import GridSample
+
+
+class MyModel(nn.Module):
+    def __init__(self, mode, padding_mode, align_corners):
+        super(MyModel, self).__init__()
+        self.grid_sample = GridSample()
+        self.attrs = (mode, padding_mode, align_corners)
+
+    def forward(self, x, grid):
+        return self.grid_sample.apply(x, grid, *self.attrs)
+
+
+class MyModelConstantGrid(nn.Module):
+    def __init__(self, grid, mode, padding_mode, align_corners):
+        super(MyModelConstantGrid, self).__init__()
+        self.grid_sample = GridSample()
+        self.attrs = (mode, padding_mode, align_corners)
+        self.register_buffer('grid', grid)
+
+    def forward(self, x):
+        return self.grid_sample.apply(x, self.grid, *self.attrs)
+
+
+def export(inp_shape=[2, 3, 10, 12], grid_shape=[2, 7, 9, 2], constant_grid=False,
+           mode='bilinear', padding_mode='zeros', align_corners=True):
+    np.random.seed(324)
+    torch.manual_seed(32)
+
+    inp = Variable(torch.randn(inp_shape))
+    # Some of the points are outside of the input
+    grid = Variable(torch.rand(grid_shape) * 2.4 - 1.2)
+    attrs = (mode, padding_mode, align_corners)
+    model = MyModelConstantGrid(grid, *attrs) if constant_grid else MyModel(*attrs)
+    args = (inp,) if constant_grid else (inp, grid)
+    model.eval()
+
+    with torch.no_grad():
+        torch.onnx.export(model, args, 'model.onnx',
+                          input_names=['input', 'input1'][:len(args)],
+                          output_names=['output'],
+                          operator_export_type=torch.onnx.OperatorExportTypes.ONNX_FALLTHROUGH)
+
+    ref = model(*args)
+    return [arg.detach().numpy() for arg in args], ref.detach().numpy()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--inp_shape', type=int, nargs='+', default=[2, 3, 10, 12])
+    parser.add_argument('--grid_shape', type=int, nargs='+', default=[2, 7, 9, 2])
+    parser.add_argument('--constant_grid', action='store_true')
+    parser.add_argument('--mode', default='bilinear', choices=['nearest', 'bilinear', 'bicubic'])
+    parser.add_argument('--padding_mode', default='zeros', choices=['zeros', 'border', 'reflection'])
+    parser.add_argument('--no_align_corners', action='store_true')
+    args = parser.parse_args()
+    export(args.inp_shape, args.grid_shape, args.constant_grid,
+           args.mode, args.padding_mode, not args.no_align_corners)
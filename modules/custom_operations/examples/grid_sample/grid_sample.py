@@ -0,0 +1,16 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import torch
+import torch.nn.functional as F
+
+
+class GridSample(torch.autograd.Function):
+    @staticmethod
+    def symbolic(g, input, grid, mode='bilinear', padding_mode='zeros', align_corners=True):
+        return g.op('GridSample', input, grid, mode_s=mode, padding_mode_s=padding_mode,
+                    align_corners_i=int(align_corners))
+
+    @staticmethod
+    def forward(self, input, grid, mode='bilinear', padding_mode='zeros', align_corners=True):
+        return F.grid_sample(input, grid, mode=mode, padding_mode=padding_mode, align_corners=align_corners)
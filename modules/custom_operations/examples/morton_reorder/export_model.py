@@ -0,0 +1,64 @@
+# Copyright (C) 2018-2024 Intel Corporation
+# SPDX-License-Identifier: Apache-2.0
+
+import argparse
+import numpy as np
+import onnx
+from onnx import helper, TensorProto
+
+
+def morton_order(pos):
+    # Voxels are counted from the minimal coordinates, bits of x are the most significant ones
+    voxels = np.floor(pos - pos.min(axis=0)).astype(np.uint64)
+    key = np.zeros(pos.shape[0], dtype=np.uint64)
+    for bit in range(21):
+        for k in range(3):
+            key |= ((voxels[:, k] >> np.uint64(bit)) & np.uint64(1)) << np.uint64(3 * bit + 2 - k)
+    return np.argsort(key, kind='stable')
+
+
+def export(num_points, num_channels, max_grid_extent, num_clouds=None):
+    np.random.seed(21)
+    # Without row splits a negative coordinate terminates the cloud
+    pos = np.random.rand(num_points, 3) * max_grid_extent
+    if num_clouds:
+        pos = pos * 2 - max_grid_extent
+    pos = pos.astype(np.float32)
+    features = np.random.randn(num_points, num_channels).astype(np.float32)
+
+    inputs = [helper.make_tensor_value_info('input', TensorProto.FLOAT, [None, 3]),
+              helper.make_tensor_value_info('input1', TensorProto.FLOAT, [None, num_channels])]
+    row_splits = [0, num_points]
+    if num_clouds:
+        sizes = np.random.multinomial(num_points, [1.0 / num_clouds] * num_clouds)
+        row_splits = np.cumsum(np.concatenate([[0], sizes])).astype(np.int64)
+        inputs.append(helper.make_tensor_value_info('input2', TensorProto.INT64, [None]))
+
+    node = helper.make_node('MortonReorder', [inp.name for inp in inputs], ['output', 'output1', 'output2'])
+    graph = helper.make_graph(
+        [node], 'morton_reorder', inputs,
+        [helper.make_tensor_value_info('output', TensorProto.FLOAT, [None, 3]),
+         helper.make_tensor_value_info('output1', TensorProto.FLOAT, [None, num_channels]),
+         helper.make_tensor_value_info('output2', TensorProto.INT64, [None])])
+    onnx.save(helper.make_model(graph), 'model.onnx')
+
+    # Every cloud is sorted separately
+    order = np.concatenate([begin + morton_order(pos[begin:end])
+                            for begin, end in zip(row_splits[:-1], row_splits[1:]) if end > begin])
+    ref = pos[order]
+
+    inp = [pos, features]
+    if num_clouds:
+        inp.append(row_splits)
+    return inp, ref
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Generate ONNX model and test data')
+    parser.add_argument('--num_points', type=int, default=1000)
+    parser.add_argument('--num_channels', type=int, default=8)
+    parser.add_argument('--max_grid_extent', type=int, default=20)
+    parser.add_argument('--num_clouds', type=int)
+    args = parser.parse_args()
+
+    export(args.num_points, args.num_channels, args.max_grid_extent, args.num_clouds)
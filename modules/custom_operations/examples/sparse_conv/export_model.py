@@ -10,7 +10,7 @@ from .sparse_conv import SparseConvONNX, SparseConvTransposeONNX
 
 
 def export(num_inp_points, num_out_points, max_grid_extent,
-           in_channels, filters, kernel_size, transpose):
+           in_channels, filters, kernel_size, transpose, num_clouds=None, quantize=None):
     np.random.seed(324)
     torch.manual_seed(32)
 
@@ -34,8 +34,15 @@ def export(num_inp_points, num_out_points, max_grid_extent,
         inp_pos = torch.tensor(inp_pos) + torch.rand(inp_pos.shape, dtype=torch.float32) # [0, 1)
         return inp_pos
 
-    inp_pos = gen_pos(num_inp_points)
-    out_pos = gen_pos(num_out_points) if num_out_points else inp_pos
+    # A batch of clouds is concatenated and split by row splits
+    inp_clouds = [gen_pos(num_inp_points) for _ in range(num_clouds or 1)]
+    out_clouds = [gen_pos(num_out_points) for _ in inp_clouds] if num_out_points else inp_clouds
+    inp_pos = torch.cat(inp_clouds)
+    out_pos = torch.cat(out_clouds)
+    row_splits = []
+    if num_clouds:
+        row_splits = [torch.tensor(np.cumsum([0] + [cloud.shape[0] for cloud in clouds]))
+                      for clouds in [inp_clouds, out_clouds]]
 
     features = torch.randn([inp_pos.shape[0], in_channels])
 
@@ -43,18 +50,29 @@ def export(num_inp_points, num_out_points, max_grid_extent,
     sparse_conv.eval()
 
     new_kernel = torch.randn(sparse_conv.state_dict()["kernel"].shape)
+    if quantize:
+        # Symmetric quantization: u8 or i8 features and i8 kernel with a scale of every output channel.
+        # The reference is computed from dequantized values.
+        if quantize == 'u8':
+            features = features.abs()
+        max_value, dtype = (255, torch.uint8) if quantize == 'u8' else (127, torch.int8)
+        sparse_conv.feature_scale = features.abs().max() / max_value
+        features = torch.round(features / sparse_conv.feature_scale).to(dtype)
+        sparse_conv.kernel_scales = new_kernel.abs().amax(dim=(0, 1, 2, 3)) / 127
+        new_kernel = torch.round(new_kernel / sparse_conv.kernel_scales) * sparse_conv.kernel_scales
     sparse_conv.load_state_dict({"kernel": new_kernel,
                                  "offset": sparse_conv.state_dict()["offset"]})
 
+    input_names = ['input', 'input1', 'input2', 'voxel_size', 'input3', 'input4'][:4 + len(row_splits)]
     with torch.no_grad():
-        torch.onnx.export(sparse_conv, (features, inp_pos, out_pos, voxel_size), 'model.onnx',
-                          input_names=['input', 'input1', 'input2', 'voxel_size'],
+        torch.onnx.export(sparse_conv, (features, inp_pos, out_pos, voxel_size, *row_splits), 'model.onnx',
+                          input_names=input_names,
                           output_names=['output'],
                           operator_export_type=torch.onnx.OperatorExportTypes.ONNX_ATEN_FALLBACK)
 
-    ref = sparse_conv(features, inp_pos, out_pos, voxel_size)
+    ref = sparse_conv(features, inp_pos, out_pos, voxel_size, *row_splits)
     return [features.detach().numpy(), inp_pos.detach().numpy(),
-            out_pos.detach().numpy()], ref.detach().numpy()
+            out_pos.detach().numpy()] + [splits.numpy() for splits in row_splits], ref.detach().numpy()
 
 
 if __name__ == "__main__":
@@ -66,7 +84,9 @@ if __name__ == "__main__":
     parser.add_argument('--filters', type=int)
     parser.add_argument('--kernel_size', type=int, nargs='+')
     parser.add_argument('--transpose', action='store_true')
+    parser.add_argument('--num_clouds', type=int)
+    parser.add_argument('--quantize', choices=['u8', 'i8'])
     args = parser.parse_args()
 
     export(args.num_inp_points, args.num_out_points, args.max_grid_extent,
-           args.in_channels, args.filters, args.kernel_size, args.transpose)
+           args.in_channels, args.filters, args.kernel_size, args.transpose, args.num_clouds, args.quantize)
@@ -6,18 +6,45 @@ import torch.nn as nn
 import torch.nn.functional as F
 from open3d.ml.torch.layers import SparseConv, SparseConvTranspose
 
+def forward_clouds(forward, feat, in_pos, out_pos, voxel_size, in_row_splits, out_row_splits):
+    if in_row_splits is None:
+        return forward(feat, in_pos, out_pos, voxel_size)
+    # Every cloud of a batch is processed separately
+    return torch.cat([forward(feat[a:b], in_pos[a:b], out_pos[c:d], voxel_size)
+                      for a, b, c, d in zip(in_row_splits[:-1], in_row_splits[1:],
+                                            out_row_splits[:-1], out_row_splits[1:])])
+
+
+def dequantize(cls, feat):
+    # Quantized features are u8 or i8 values of a symmetric quantization
+    if feat.dtype.is_floating_point:
+        return feat
+    return feat.float() * cls.feature_scale
+
+
+def kernel_constants(g, cls):
+    kernel = cls.state_dict()["kernel"]
+    offset = cls.state_dict()["offset"]
+    scales = []
+    if getattr(cls, "kernel_scales", None) is not None:
+        # i8 kernel and scales of output channels which include the scale of features
+        kernel = torch.round(kernel / cls.kernel_scales).to(torch.int8)
+        scales = [g.op("Constant", value_t=cls.kernel_scales * cls.feature_scale)]
+    return g.op("Constant", value_t=kernel), g.op("Constant", value_t=offset), scales
+
+
 class SparseConvFunc(torch.autograd.Function):
     @staticmethod
-    def symbolic(g, cls, feat, in_pos, out_pos, voxel_size):
-        kernel = cls.state_dict()["kernel"]
-        offset = cls.state_dict()["offset"]
-        kernel = g.op("Constant", value_t=kernel)
-        offset = g.op("Constant", value_t=offset)
-        return g.op("SparseConv", feat, in_pos, out_pos, kernel, offset)
+    def symbolic(g, cls, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        kernel, offset, scales = kernel_constants(g, cls)
+        if in_row_splits is None:
+            return g.op("SparseConv", feat, in_pos, out_pos, kernel, offset, *scales)
+        return g.op("SparseConv", feat, in_pos, out_pos, kernel, offset, in_row_splits, out_row_splits, *scales)
 
     @staticmethod
-    def forward(self, cls, feat, in_pos, out_pos, voxel_size):
-        return cls.origin_forward(feat, in_pos, out_pos, voxel_size)
+    def forward(self, cls, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        return forward_clouds(cls.origin_forward, dequantize(cls, feat), in_pos, out_pos, voxel_size,
+                              in_row_splits, out_row_splits)
 
 
 class SparseConvONNX(SparseConv):
@@ -28,22 +55,23 @@ class SparseConvONNX(SparseConv):
         super().__init__(*args, **kwargs)
         self.origin_forward = super().forward
 
-    def forward(self, feat, in_pos, out_pos, voxel_size):
-        return SparseConvFunc.apply(self, feat, in_pos, out_pos, voxel_size)
+    def forward(self, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        return SparseConvFunc.apply(self, feat, in_pos, out_pos, voxel_size, in_row_splits, out_row_splits)
 
 
 class SparseConvTransposeFunc(torch.autograd.Function):
     @staticmethod
-    def symbolic(g, cls, feat, in_pos, out_pos, voxel_size):
-        kernel = cls.state_dict()["kernel"]
-        offset = cls.state_dict()["offset"]
-        kernel = g.op("Constant", value_t=kernel)
-        offset = g.op("Constant", value_t=offset)
-        return g.op("SparseConvTranspose", feat, in_pos, out_pos, kernel, offset)
+    def symbolic(g, cls, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        kernel, offset, scales = kernel_constants(g, cls)
+        if in_row_splits is None:
+            return g.op("SparseConvTranspose", feat, in_pos, out_pos, kernel, offset, *scales)
+        return g.op("SparseConvTranspose", feat, in_pos, out_pos, kernel, offset, in_row_splits, out_row_splits,
+                    *scales)
 
     @staticmethod
-    def forward(self, cls, feat, in_pos, out_pos, voxel_size):
-        return cls.origin_forward(feat, in_pos, out_pos, voxel_size)
+    def forward(self, cls, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        return forward_clouds(cls.origin_forward, dequantize(cls, feat), in_pos, out_pos, voxel_size,
+                              in_row_splits, out_row_splits)
 
 
 class SparseConvTransposeONNX(SparseConvTranspose):
@@ -54,5 +82,5 @@ class SparseConvTransposeONNX(SparseConvTranspose):
         super().__init__(*args, **kwargs)
         self.origin_forward = super().forward
 
-    def forward(self, feat, in_pos, out_pos, voxel_size):
-        return SparseConvTransposeFunc.apply(self, feat, in_pos, out_pos, voxel_size)
+    def forward(self, feat, in_pos, out_pos, voxel_size, in_row_splits=None, out_row_splits=None):
+        return SparseConvTransposeFunc.apply(self, feat, in_pos, out_pos, voxel_size, in_row_splits, out_row_splits)
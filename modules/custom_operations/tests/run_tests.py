@@ -35,24 +35,205 @@ def run_test(ref_inputs, ref_res, test_onnx=False, threshold=1e-5):
     assert diff <= threshold
 
 
+# Changes inputs and outputs of model.onnx to f16, so custom operations are evaluated with f16 tensors.
+# Constants stay in f32.
+def to_half_precision(ref_inputs):
+    import onnx
+
+    model = onnx.load('model.onnx')
+    for value in list(model.graph.input) + list(model.graph.output):
+        value.type.tensor_type.elem_type = onnx.TensorProto.FLOAT16
+    onnx.save(model, 'model.onnx')
+    return [inp.astype(np.float16) for inp in ref_inputs]
+
+
 @pytest.mark.parametrize("shape", [[5, 120, 2], [4, 240, 320, 2], [3, 16, 240, 320, 2], [4, 5, 16, 31, 2]])
 @pytest.mark.parametrize("inverse", [False, True])
 @pytest.mark.parametrize("centered", [False, True])
 @pytest.mark.parametrize("test_onnx", [False, True])
-@pytest.mark.parametrize("dims", [[1], [1, 2], [2, 3]])
+@pytest.mark.parametrize("dims", [[1], [1, 2], [2, 3], [1, 2, 3]])
 def test_fft(shape, inverse, centered, test_onnx, dims):
     from examples.fft.export_model import export
 
-    if len(shape) == 3 and dims != [1] or \
-       len(shape) == 4 and dims == [2, 3] or \
-       len(shape) == 5 and dims == [1] or \
-       centered and len(dims) != 2:
+    if max(dims) >= len(shape) - 1:
         pytest.skip("unsupported configuration")
 
     inp, ref = export(shape, inverse, centered, dims)
     run_test(inp, ref, test_onnx=test_onnx)
 
 
+@pytest.mark.parametrize("shape", [[5, 120], [4, 240, 320], [3, 16, 31, 2]])
+@pytest.mark.parametrize("inverse", [False, True])
+@pytest.mark.parametrize("dims", [[1], [1, 2]])
+def test_fft_real_input(shape, inverse, dims):
+    from examples.fft.export_model import export
+
+    if max(dims) >= len(shape):
+        pytest.skip("unsupported configuration")
+
+    if inverse:
+        # Half spectrum of the last signal dimension
+        shape = shape.copy()
+        shape[dims[-1]] = shape[dims[-1]] // 2 + 1
+        shape.append(2)
+
+    inp, ref = export(shape, inverse, False, dims, real_input=True)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("shape,dims", [([5, 120, 2], [1]), ([4, 24, 32, 2], [1, 2]), ([3, 6, 10, 12, 2], [1, 2, 3])])
+@pytest.mark.parametrize("inverse", [False, True])
+@pytest.mark.parametrize("centered", [False, True])
+def test_fft_f16(shape, dims, inverse, centered):
+    from examples.fft.export_model import export
+
+    inp, ref = export(shape, inverse, centered, dims)
+    run_test(to_half_precision(inp), ref, test_onnx=True, threshold=1e-2)
+
+
+@pytest.mark.parametrize("inverse", [False, True])
+def test_fft_real_input_f16(inverse):
+    from examples.fft.export_model import export
+
+    # Half spectrum of the last signal dimension for the inverse transform
+    shape = [4, 24, 17, 2] if inverse else [4, 24, 32]
+    inp, ref = export(shape, inverse, False, [1, 2], real_input=True)
+    run_test(to_half_precision(inp), ref, test_onnx=True, threshold=1e-2)
+
+
+@pytest.mark.parametrize("filter_shape", [[3, 2, 4, 8, 2], [3, 1, 4, 8, 2]])
+@pytest.mark.parametrize("centered", [False, True])
+@pytest.mark.parametrize("dims", [[2, 3], [1, 2, 3]])
+def test_fft_convolution(filter_shape, centered, dims):
+    from examples.fft_convolution.export_model import export
+
+    inp, ref = export([3, 2, 4, 8, 2], filter_shape, centered, dims)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("inp_shape,grid_shape", [([2, 3, 10, 12], [2, 7, 9, 2]),
+                                                  ([1, 32, 20, 17], [1, 11, 13, 2])])
+@pytest.mark.parametrize("test_onnx", [False, True])
+def test_grid_sample(inp_shape, grid_shape, test_onnx):
+    from examples.grid_sample.export_model import export
+
+    inp, ref = export(inp_shape, grid_shape)
+    run_test(inp, ref, test_onnx=test_onnx)
+
+
+@pytest.mark.parametrize("inp_shape,grid_shape", [([2, 3, 10, 12], [2, 7, 9, 2]),
+                                                  ([1, 32, 20, 17], [1, 11, 13, 2])])
+def test_grid_sample_constant_grid(inp_shape, grid_shape):
+    from examples.grid_sample.export_model import export
+
+    inp, ref = export(inp_shape, grid_shape, constant_grid=True)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("mode", ['nearest', 'bilinear', 'bicubic'])
+@pytest.mark.parametrize("padding_mode", ['zeros', 'border', 'reflection'])
+@pytest.mark.parametrize("align_corners", [False, True])
+def test_grid_sample_modes(mode, padding_mode, align_corners):
+    from examples.grid_sample.export_model import export
+
+    inp, ref = export([1, 3, 10, 12], [1, 7, 9, 2], mode=mode, padding_mode=padding_mode,
+                      align_corners=align_corners)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("inp_shape,grid_shape", [([2, 3, 10, 12], [2, 7, 9, 2]),
+                                                  ([1, 32, 20, 17], [1, 11, 13, 2])])
+@pytest.mark.parametrize("constant_grid", [False, True])
+def test_grid_sample_f16(inp_shape, grid_shape, constant_grid):
+    from examples.grid_sample.export_model import export
+
+    inp, ref = export(inp_shape, grid_shape, constant_grid=constant_grid, mode='bicubic')
+    run_test(to_half_precision(inp), ref, test_onnx=True, threshold=1e-2)
+
+
+def test_grid_sample_scratch_peak_bytes():
+    import ctypes
+    from examples.grid_sample.export_model import export
+
+    lib = ctypes.CDLL(os.getenv('CUSTOM_OP_LIB'))
+    lib.user_ov_extensions_get_peak_scratch_bytes.restype = ctypes.c_size_t
+    lib.user_ov_extensions_reset_peak_scratch_bytes()
+
+    # Input with many channels is transposed to a scratch buffer
+    inp_shape = [1, 32, 20, 17]
+    inp, ref = export(inp_shape, [1, 11, 13, 2])
+    run_test(inp, ref, test_onnx=True)
+    assert lib.user_ov_extensions_get_peak_scratch_bytes(b'GridSample') >= np.prod(inp_shape) * 4
+
+
+def test_grid_sample_scratch_retain_limit():
+    import ctypes
+    from examples.grid_sample.export_model import export
+
+    lib = ctypes.CDLL(os.getenv('CUSTOM_OP_LIB'))
+    lib.user_ov_extensions_set_scratch_retain_limit.restype = ctypes.c_size_t
+    lib.user_ov_extensions_set_scratch_retain_limit.argtypes = [ctypes.c_size_t]
+
+    # Every scratch buffer is freed after use and allocated again by the next evaluate call
+    prev_limit = lib.user_ov_extensions_set_scratch_retain_limit(0)
+    assert prev_limit == ctypes.c_size_t(-1).value
+    try:
+        inp, ref = export([1, 32, 20, 17], [1, 11, 13, 2])
+        run_test(inp, ref, test_onnx=True)
+        run_test(inp, ref, test_onnx=True)
+    finally:
+        assert lib.user_ov_extensions_set_scratch_retain_limit(prev_limit) == 0
+
+
+def test_sparse_conv_profile():
+    import ctypes
+    import json
+    from examples.sparse_conv.export_model import export
+
+    lib = ctypes.CDLL(os.getenv('CUSTOM_OP_LIB'))
+    lib.user_ov_extensions_get_profile_json.restype = ctypes.c_size_t
+    lib.user_ov_extensions_set_profiling(1)
+    lib.user_ov_extensions_reset_profile()
+
+    # Channels are enough for rulebook GEMM
+    inp, ref = export(num_inp_points=1000, num_out_points=None, max_grid_extent=4, in_channels=16,
+                      filters=16, kernel_size=[3, 3, 3], transpose=False)
+    run_test(inp, ref, test_onnx=True, threshold=1e-4)
+    lib.user_ov_extensions_set_profiling(0)
+
+    size = lib.user_ov_extensions_get_profile_json(None, 0)
+    buffer = ctypes.create_string_buffer(size + 1)
+    lib.user_ov_extensions_get_profile_json(buffer, len(buffer))
+    phases = json.loads(buffer.value)['SparseConv']
+    assert phases['total']['calls'] >= 1
+    for phase in ['grid', 'neighbor_search', 'gemm']:
+        assert phases[phase]['calls'] >= 1 and phases[phase]['ns'] > 0
+
+
+def test_sparse_conv_max_threads():
+    import ctypes
+    import json
+    from examples.sparse_conv.export_model import export
+
+    lib = ctypes.CDLL(os.getenv('CUSTOM_OP_LIB'))
+    lib.user_ov_extensions_get_profile_json.restype = ctypes.c_size_t
+    lib.user_ov_extensions_set_max_threads(b'SparseConv', 1)
+    lib.user_ov_extensions_set_profiling(1)
+    lib.user_ov_extensions_reset_profile()
+
+    inp, ref = export(num_inp_points=1000, num_out_points=None, max_grid_extent=4, in_channels=16,
+                      filters=16, kernel_size=[3, 3, 3], transpose=False)
+    run_test(inp, ref, test_onnx=True, threshold=1e-4)
+    lib.user_ov_extensions_set_profiling(0)
+    lib.user_ov_extensions_set_max_threads(b'SparseConv', 0)
+
+    buffer = ctypes.create_string_buffer(lib.user_ov_extensions_get_profile_json(None, 0) + 1)
+    lib.user_ov_extensions_get_profile_json(buffer, len(buffer))
+    phases = json.loads(buffer.value)['SparseConv']
+    # A single thread searches neighbors of all the output points of a call
+    assert phases['neighbor_search']['calls'] == phases['total']['calls']
+
+
 @pytest.mark.parametrize("shape", [[3, 2, 4, 8, 2], [3, 1, 4, 8, 2]])
 @pytest.mark.parametrize("test_onnx", [False, True])
 def test_complex_mul(shape, test_onnx):
@@ -62,6 +243,26 @@ def test_complex_mul(shape, test_onnx):
     run_test(inp, ref, test_onnx=test_onnx)
 
 
+@pytest.mark.parametrize("inp_shape,other_shape", [([3, 2, 4, 8, 2], [4, 8, 2]),
+                                                   ([3, 2, 4, 8, 2], [3, 1, 1, 1, 2]),
+                                                   ([3, 2, 4, 8, 2], [1, 2, 4, 1, 2]),
+                                                   ([3, 1, 4, 8, 2], [3, 2, 4, 8, 2]),
+                                                   ([5, 1, 7, 2], [1, 6, 1, 2])])
+def test_complex_mul_broadcast(inp_shape, other_shape):
+    from examples.complex_mul.export_model import export
+
+    inp, ref = export(inp_shape=inp_shape, other_shape=other_shape)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("other_shape", [[3, 2, 4, 8, 2], [4, 8, 2], [3, 1, 1, 1, 2]])
+def test_complex_mul_f16(other_shape):
+    from examples.complex_mul.export_model import export
+
+    inp, ref = export(other_shape=other_shape)
+    run_test(to_half_precision(inp), ref, test_onnx=True, threshold=2e-2)
+
+
 @pytest.mark.parametrize("in_channels", [1, 3])
 @pytest.mark.parametrize("filters", [1, 4])
 @pytest.mark.parametrize("kernel_size", [[3, 3, 3], [5, 5, 5], [2, 2, 2]])
@@ -86,7 +287,120 @@ def test_sparse_conv_transpose(in_channels, filters, kernel_size, out_pos):
     run_test(inp, ref, test_onnx=True, threshold=1e-4)
 
 
+# Channels are enough for rulebook GEMM. A grid of 5x5x5 voxels gives 125 pairs of the central kernel offset,
+# which is more than one block of gathered rows and not a multiple of the rows sharing loaded weights.
+@pytest.mark.parametrize("in_channels,filters", [(16, 16), (19, 20)])
+@pytest.mark.parametrize("kernel_size", [[3, 3, 3], [2, 2, 2]])
+@pytest.mark.parametrize("transpose", [False, True])
+@pytest.mark.parametrize("out_pos", [None, 16])
+def test_sparse_conv_gemm(in_channels, filters, kernel_size, transpose, out_pos):
+    from examples.sparse_conv.export_model import export
+
+    inp, ref = export(num_inp_points=1000, num_out_points=out_pos, max_grid_extent=5, in_channels=in_channels,
+                      filters=filters, kernel_size=kernel_size, transpose=transpose)
+    run_test(inp, ref, test_onnx=True, threshold=1e-4)
+
+
+@pytest.mark.parametrize("transpose", [False, True])
+@pytest.mark.parametrize("out_pos", [None, 16])
+def test_sparse_conv_batched(transpose, out_pos):
+    from examples.sparse_conv.export_model import export
+
+    inp, ref = export(num_inp_points=300, num_out_points=out_pos, max_grid_extent=4, in_channels=3,
+                      filters=4, kernel_size=[3, 3, 3], transpose=transpose, num_clouds=3)
+    run_test(inp, ref, test_onnx=True, threshold=1e-4)
+
+
+@pytest.mark.parametrize("quantize", ['u8', 'i8'])
+@pytest.mark.parametrize("transpose", [False, True])
+@pytest.mark.parametrize("num_clouds", [None, 3])
+def test_sparse_conv_int8(quantize, transpose, num_clouds):
+    from examples.sparse_conv.export_model import export
+
+    inp, ref = export(num_inp_points=300, num_out_points=16, max_grid_extent=4, in_channels=19,
+                      filters=20, kernel_size=[3, 3, 3], transpose=transpose, num_clouds=num_clouds,
+                      quantize=quantize)
+    run_test(inp, ref, test_onnx=True, threshold=1e-4)
+
+
 def test_calculate_grid():
     from examples.calculate_grid.export_model import export
     inp, ref = export(num_points=10, max_grid_extent=5)
     run_test(inp, ref, test_onnx=True)
+
+
+# Enough points for radix sort of keys by several threads
+@pytest.mark.parametrize("order", ['lexicographic', 'morton'])
+def test_calculate_grid_large(order):
+    from examples.calculate_grid.export_model import export
+    inp, ref = export(num_points=50000, max_grid_extent=200, order=order)
+    run_test(inp, ref, test_onnx=True)
+
+
+# Voxels of coordinates from 2^22 do not fit packed keys and are sorted by the fallback
+def test_calculate_grid_large_coordinates():
+    from examples.calculate_grid.export_model import export
+    inp, ref = export(num_points=1000, max_grid_extent=20, origin=2 ** 22)
+    run_test(inp, ref, test_onnx=True)
+
+
+def test_calculate_grid_batched():
+    from examples.calculate_grid.export_model import export
+    inp, ref = export(num_points=100, max_grid_extent=5, num_clouds=4)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("num_clouds", [None, 3])
+def test_calculate_grid_morton(num_clouds):
+    from examples.calculate_grid.export_model import export
+    inp, ref = export(num_points=200, max_grid_extent=20, num_clouds=num_clouds, order='morton')
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("num_clouds", [None, 3])
+def test_morton_reorder(num_clouds):
+    from examples.morton_reorder.export_model import export
+    inp, ref = export(num_points=500, num_channels=4, max_grid_extent=20, num_clouds=num_clouds)
+    run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("max_length", [0, 4])
+@pytest.mark.parametrize("unk_token_id", [-1, 1])
+def test_bpe_tokenizer(max_length, unk_token_id):
+    from examples.bpe_tokenizer.export_model import export
+    corpus = ['low lower lowest newer wider', 'the then there their', 'lowest newest widest']
+    texts = ['low lower  lowest', 'newer wider\tthe', '', 'xyz theirs', 'héllo wörld']
+    inp, ref = export(texts, corpus=corpus, num_merges=20, max_length=max_length, unk_token_id=unk_token_id)
+    run_test(inp, ref, test_onnx=True)
+
+
+# Texts, vocabulary and merges packed with 64-bit offsets give the same ids as with 32-bit ones
+@pytest.mark.parametrize("max_length", [0, 4])
+def test_bpe_tokenizer_offsets64(max_length):
+    from examples.bpe_tokenizer.export_model import export
+    corpus = ['low lower lowest newer wider', 'the then there their', 'lowest newest widest']
+    texts = ['low lower  lowest', 'newer wider\tthe', '', 'xyz theirs', 'héllo wörld']
+    inp, ref = export(texts, corpus=corpus, num_merges=20, max_length=max_length, packed_format='offsets64')
+    run_test(inp, ref, test_onnx=True)
+
+
+# Input with the marker of 64-bit offsets and an unknown version or without the rest of the header is rejected
+@pytest.mark.parametrize("corrupt", ['version', 'header'])
+def test_bpe_tokenizer_offsets64_invalid(corrupt):
+    from examples.bpe_tokenizer.export_model import export
+    texts = ['low lower lowest', 'newer wider']
+    inp, ref = export(texts, num_merges=20, packed_format='offsets64')
+    if corrupt == 'version':
+        inp[0][4] = 3
+    else:
+        inp[0] = inp[0][:8]
+    with pytest.raises(Exception):
+        run_test(inp, ref, test_onnx=True)
+
+
+@pytest.mark.parametrize("suffix", ['', '</w>'])
+def test_detokenizer(suffix):
+    from examples.bpe_tokenizer.export_model import export_detokenizer
+    texts = ['low lower  lowest', 'newer wider\tthe', '', 'héllo wörld']
+    inp, ref = export_detokenizer(texts, corpus=texts + ['the then there their'], num_merges=20, suffix=suffix)
+    run_test(inp, ref, test_onnx=True)
@@ -0,0 +1,115 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Round trips of openvino_extensions/strings.hpp through preallocated tensors. Exits with a non-zero code
+// and a message of the first failed check.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "openvino_extensions/strings.hpp"
+
+using namespace openvino_extensions;
+
+namespace {
+
+#define CHECK(cond)                                                                        \
+    do {                                                                                   \
+        if (!(cond)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                                  \
+        }                                                                                  \
+    } while (0)
+
+std::vector<std::string> makeStrings(size_t batch, size_t maxLength) {
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < batch; ++i)
+        strings.emplace_back((i * 7919) % (maxLength + 1), static_cast<char>('a' + i % 26));
+    return strings;
+}
+
+// Packs strings into a tensor which is larger than required and unpacks them back
+template <typename BatchOfStrings>
+void testPackTo(const BatchOfStrings& strings, packed_strings_format format) {
+    const size_t packedSize = get_packed_strings_size(strings, format);
+    ov::Tensor tensor(ov::element::u8, ov::Shape{packedSize + 100});
+    const size_t written = pack_strings_to(strings, tensor, format);
+    CHECK(written == packedSize);
+    CHECK(tensor.get_shape() == ov::Shape{packedSize + 100});
+
+    const std::vector<std::string> unpacked = unpack_strings(tensor);
+    CHECK(unpacked.size() == strings.size());
+    CHECK(std::equal(unpacked.begin(), unpacked.end(), strings.begin()));
+
+    ov::Tensor reshaped(ov::element::u8, ov::Shape{0});
+    pack_strings(strings, reshaped, format);
+    CHECK(reshaped.get_byte_size() == packedSize);
+    CHECK(std::equal(reshaped.data<uint8_t>(), reshaped.data<uint8_t>() + packedSize, tensor.data<uint8_t>()));
+
+#ifdef OPENVINO_EXTENSIONS_STRING_VIEW
+    // Views point into the tensor and are packed again without copies to std::string
+    ov::Tensor repacked(ov::element::u8, ov::Shape{packedSize});
+    CHECK(pack_strings_to(unpack_string_views(tensor), repacked, format) == packedSize);
+    CHECK(std::equal(repacked.data<uint8_t>(), repacked.data<uint8_t>() + packedSize, tensor.data<uint8_t>()));
+#endif
+}
+
+template <typename Function>
+bool throws(Function function) {
+    try {
+        function();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+void testTooSmall() {
+    const std::vector<std::string> strings = makeStrings(10, 20);
+    ov::Tensor tensor(ov::element::u8, ov::Shape{get_packed_strings_size(strings) - 1});
+    CHECK(throws([&]() { pack_strings_to(strings, tensor); }));
+}
+
+// Headers of the 64-bit layout which do not match the tensor are rejected by unpacking
+void testInvalidOffsets64() {
+    const std::vector<std::string> strings = makeStrings(10, 20);
+    ov::Tensor tensor(ov::element::u8, ov::Shape{0});
+    pack_strings(strings, tensor, packed_strings_format::offsets64);
+
+    ov::Tensor version(ov::element::u8, tensor.get_shape());
+    std::copy(tensor.data<uint8_t>(), tensor.data<uint8_t>() + tensor.get_byte_size(), version.data<uint8_t>());
+    reinterpret_cast<int32_t*>(version.data<uint8_t>())[1] = 3;
+    CHECK(throws([&]() { unpack_strings(version); }));
+
+    ov::Tensor header(ov::element::u8, ov::Shape{8});
+    std::copy(tensor.data<uint8_t>(), tensor.data<uint8_t>() + 8, header.data<uint8_t>());
+    CHECK(throws([&]() { unpack_strings(header); }));
+
+    ov::Tensor batch(ov::element::u8, tensor.get_shape());
+    std::copy(tensor.data<uint8_t>(), tensor.data<uint8_t>() + tensor.get_byte_size(), batch.data<uint8_t>());
+    reinterpret_cast<uint64_t*>(batch.data<uint8_t>())[1] = uint64_t(1) << 60;
+    CHECK(throws([&]() { unpack_strings(batch); }));
+}
+
+}  // namespace
+
+int main() {
+    const packed_strings_format formats[] = {packed_strings_format::automatic, packed_strings_format::offsets32,
+                                             packed_strings_format::offsets64};
+    for (packed_strings_format format : formats) {
+        testPackTo(std::vector<std::string>(), format);
+        testPackTo(makeStrings(100, 30), format);
+        const std::vector<std::string> strings = makeStrings(50, 30);
+        testPackTo(std::list<std::string>(strings.begin(), strings.end()), format);
+        testPackTo(makeStrings(5000, 8000), format);
+    }
+    testTooSmall();
+    testInvalidOffsets64();
+    std::printf("strings_test passed\n");
+    return 0;
+}
@@ -0,0 +1,363 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "bpe_tokenizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/op/constant.hpp>
+
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "openvino_extensions/strings.hpp"
+#include "scratch_arena.hpp"
+
+using namespace TemplateExtension;
+
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("BPETokenizer");
+OpThreads& opThreads = getOpThreads("BPETokenizer");
+ProfilePhase& totalPhase = getProfilePhase("BPETokenizer", "total");
+
+// Id of symbols which are not in the vocabulary. They are never merged.
+const int32_t unknownSymbol = -1;
+
+// Marks symbols which are merged into their left neighbours
+const int32_t removedSymbol = -2;
+
+struct Merge {
+    int32_t rank;
+    int32_t id;
+};
+
+// Token which points to bytes of the vocabulary. Lookups by such keys do not allocate strings.
+struct TokenRef {
+    const char* data;
+    size_t size;
+
+    bool operator==(const TokenRef& other) const {
+        return size == other.size && std::equal(data, data + size, other.data);
+    }
+};
+
+// FNV-1a hash of token bytes
+struct TokenRefHash {
+    size_t operator()(const TokenRef& token) const {
+        uint64_t h = 14695981039346656037ull;
+        for (size_t i = 0; i < token.size; ++i)
+            h = (h ^ static_cast<unsigned char>(token.data[i])) * 1099511628211ull;
+        return static_cast<size_t>(h);
+    }
+};
+
+// Pair of adjacent symbols where pos is the left symbol
+struct QueuedPair {
+    int32_t rank;
+    int32_t pos;
+};
+
+// Orders a heap of pairs by the lowest rank and then by the leftmost position, which is
+// the order of merges of BPE
+bool isLaterPair(const QueuedPair& a, const QueuedPair& b) {
+    return a.rank > b.rank || (a.rank == b.rank && a.pos > b.pos);
+}
+
+// Scratch buffers of a task which tokenizes a text. Every byte of a word may be a symbol, and the queue
+// takes pairs of the initial symbols and two new pairs per merge.
+struct WordScratch {
+    WordScratch(size_t textSize, size_t suffixSize)
+        : symbols(scratchStats, textSize),
+          prev(scratchStats, textSize),
+          next(scratchStats, textSize),
+          queue(scratchStats, 3 * textSize),
+          lastSymbol(scratchStats, 4 + suffixSize) {}
+
+    ScratchBuffer<int32_t> symbols;
+    ScratchBuffer<int32_t> prev;
+    ScratchBuffer<int32_t> next;
+    ScratchBuffer<QueuedPair> queue;
+    // The last character of a word followed by the end of word suffix
+    ScratchBuffer<char> lastSymbol;
+};
+
+uint64_t getPairKey(int32_t left, int32_t right) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(left)) << 32) | static_cast<uint32_t>(right);
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Number of bytes of a UTF-8 character by its first byte. Invalid bytes are separate symbols.
+size_t getCharLength(unsigned char c) {
+    if ((c >> 5) == 0x6)
+        return 2;
+    if ((c >> 4) == 0xE)
+        return 3;
+    if ((c >> 3) == 0x1E)
+        return 4;
+    return 1;
+}
+
+}  // namespace
+
+struct BPETokenizer::Vocab {
+    // Bytes of all the tokens, which keys of the tokens map point to
+    std::vector<char> tokenData;
+    std::unordered_map<TokenRef, int32_t, TokenRefHash> tokens;
+    // Pairs of token ids mapped to their ranks and ids of merged tokens
+    std::unordered_map<uint64_t, Merge> merges;
+
+    Vocab(const ov::Tensor& vocab, const ov::Tensor& mergesTensor) {
+        const auto vocabLayout = openvino_extensions::detail::get_packed_strings_layout(vocab);
+        OPENVINO_ASSERT(vocabLayout.batch_size <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                        "BPETokenizer vocabulary is too large");
+        size_t dataSize = 0;
+        for (size_t i = 0; i < vocabLayout.batch_size; ++i)
+            dataSize += vocabLayout.get_end(i) - vocabLayout.get_begin(i);
+        // Keys point to the data, so it is never reallocated
+        tokenData.reserve(dataSize);
+        tokens.reserve(vocabLayout.batch_size);
+        for (size_t i = 0; i < vocabLayout.batch_size; ++i) {
+            const char* begin = vocabLayout.symbols + vocabLayout.get_begin(i);
+            const char* end = vocabLayout.symbols + vocabLayout.get_end(i);
+            const size_t offset = tokenData.size();
+            tokenData.insert(tokenData.end(), begin, end);
+            // The first occurrence of a duplicated token keeps its id
+            tokens.emplace(TokenRef{tokenData.data() + offset, static_cast<size_t>(end - begin)},
+                           static_cast<int32_t>(i));
+        }
+
+        const auto mergesLayout = openvino_extensions::detail::get_packed_strings_layout(mergesTensor);
+        merges.reserve(mergesLayout.batch_size);
+        std::string merged;
+        for (size_t i = 0; i < mergesLayout.batch_size; ++i) {
+            const char* begin = mergesLayout.symbols + mergesLayout.get_begin(i);
+            const char* end = mergesLayout.symbols + mergesLayout.get_end(i);
+            const char* space = std::find(begin, end, ' ');
+            if (space == end)
+                continue;
+            // Merges of tokens which are not in the vocabulary can not be applied
+            const int32_t left = findToken(begin, space);
+            const int32_t right = findToken(space + 1, end);
+            merged.assign(begin, space);
+            merged.append(space + 1, end);
+            const int32_t id = findToken(merged.data(), merged.data() + merged.size());
+            if (left == unknownSymbol || right == unknownSymbol || id == unknownSymbol)
+                continue;
+            merges.emplace(getPairKey(left, right), Merge{static_cast<int32_t>(i), id});
+        }
+    }
+
+    int32_t findToken(const char* begin, const char* end) const {
+        const auto it = tokens.find(TokenRef{begin, static_cast<size_t>(end - begin)});
+        return it == tokens.end() ? unknownSymbol : it->second;
+    }
+
+    // Returns a merge of two symbols or nullptr
+    const Merge* findMerge(int32_t left, int32_t right) const {
+        if (left < 0 || right < 0)
+            return nullptr;
+        const auto it = merges.find(getPairKey(left, right));
+        return it == merges.end() ? nullptr : &it->second;
+    }
+
+    // Splits a word into characters and merges the pair of the lowest rank until no pairs can be merged.
+    // Symbols form a linked list, and a merge changes only the pairs with the neighbours of the merged
+    // symbol, so only those pairs are queued again. Queued pairs which have been changed since are skipped.
+    // Ids are appended to ids[numIds] until there are maxIds of them.
+    void tokenizeWord(const char* begin, const char* end, const std::string& suffix, WordScratch& scratch,
+                      int64_t unkId, int64_t* ids, size_t& numIds, size_t maxIds) const {
+        int32_t* symbols = scratch.symbols.data();
+        int32_t* prev = scratch.prev.data();
+        int32_t* next = scratch.next.data();
+        int32_t numSymbols = 0;
+        for (const char* c = begin; c < end;) {
+            const char* charEnd = std::min(end, c + getCharLength(static_cast<unsigned char>(*c)));
+            if (charEnd == end && !suffix.empty()) {
+                char* symbol = scratch.lastSymbol.data();
+                std::copy(suffix.begin(), suffix.end(), std::copy(c, charEnd, symbol));
+                symbols[numSymbols] = findToken(symbol, symbol + (charEnd - c) + suffix.size());
+            } else {
+                symbols[numSymbols] = findToken(c, charEnd);
+            }
+            prev[numSymbols] = numSymbols - 1;
+            next[numSymbols] = numSymbols + 1;
+            ++numSymbols;
+            c = charEnd;
+        }
+
+        QueuedPair* queue = scratch.queue.data();
+        size_t queueSize = 0;
+        auto queuePair = [&](int32_t pos) {
+            const Merge* merge = findMerge(symbols[pos], symbols[next[pos]]);
+            if (merge)
+                queue[queueSize++] = QueuedPair{merge->rank, pos};
+        };
+        for (int32_t i = 0; i + 1 < numSymbols; ++i)
+            queuePair(i);
+        std::make_heap(queue, queue + queueSize, isLaterPair);
+
+        while (queueSize > 0) {
+            std::pop_heap(queue, queue + queueSize, isLaterPair);
+            const QueuedPair pair = queue[--queueSize];
+            const int32_t pos = pair.pos;
+            if (symbols[pos] == removedSymbol || next[pos] == numSymbols)
+                continue;
+            const int32_t right = next[pos];
+            const Merge* merge = findMerge(symbols[pos], symbols[right]);
+            if (!merge || merge->rank != pair.rank)
+                continue;
+
+            symbols[pos] = merge->id;
+            symbols[right] = removedSymbol;
+            next[pos] = next[right];
+            if (next[pos] != numSymbols)
+                prev[next[pos]] = pos;
+            const size_t prevSize = queueSize;
+            if (prev[pos] >= 0)
+                queuePair(prev[pos]);
+            if (next[pos] != numSymbols)
+                queuePair(pos);
+            for (size_t i = prevSize; i < queueSize; ++i)
+                std::push_heap(queue, queue + i + 1, isLaterPair);
+        }
+
+        // Merged symbols are kept by left symbols of pairs, so the first symbol stays the head of the list
+        for (int32_t i = 0; i < numSymbols && numIds < maxIds; i = next[i]) {
+            if (symbols[i] != unknownSymbol)
+                ids[numIds++] = symbols[i];
+            else if (unkId >= 0)
+                ids[numIds++] = unkId;
+        }
+    }
+};
+
+BPETokenizer::BPETokenizer(const ov::OutputVector& args,
+                           int64_t max_length,
+                           int64_t pad_token_id,
+                           int64_t unk_token_id,
+                           const std::string& end_of_word_suffix)
+    : Op(args),
+      max_length(max_length),
+      pad_token_id(pad_token_id),
+      unk_token_id(unk_token_id),
+      end_of_word_suffix(end_of_word_suffix) {
+    constructor_validate_and_infer_types();
+}
+
+void BPETokenizer::validate_and_infer_types() {
+    OPENVINO_ASSERT(get_input_size() == 3, "BPETokenizer expects texts, vocabulary and merges inputs");
+    for (size_t i = 0; i < get_input_size(); ++i) {
+        OPENVINO_ASSERT(get_input_element_type(i) == ov::element::u8,
+                        "BPETokenizer expects packed string tensors with u8 element type");
+    }
+    OPENVINO_ASSERT(max_length >= 0, "BPETokenizer max_length must be non-negative");
+
+    // Batch size is stored inside of a packed tensor
+    const ov::PartialShape outShape{ov::Dimension::dynamic(),
+                                    max_length > 0 ? ov::Dimension(max_length) : ov::Dimension::dynamic()};
+    set_output_type(0, ov::element::i64, outShape);
+    set_output_type(1, ov::element::i64, outShape);
+
+    // Inputs might be changed
+    std::lock_guard<std::mutex> lock(vocabMutex);
+    constantVocab.reset();
+}
+
+std::shared_ptr<ov::Node> BPETokenizer::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<BPETokenizer>(new_args, max_length, pad_token_id, unk_token_id, end_of_word_suffix);
+}
+
+bool BPETokenizer::visit_attributes(ov::AttributeVisitor& visitor) {
+    visitor.on_attribute("max_length", max_length);
+    visitor.on_attribute("pad_token_id", pad_token_id);
+    visitor.on_attribute("unk_token_id", unk_token_id);
+    visitor.on_attribute("end_of_word_suffix", end_of_word_suffix);
+    return true;
+}
+
+// Returns hash maps of vocabulary and merges. Constant inputs are parsed by the first call only.
+std::shared_ptr<const BPETokenizer::Vocab> BPETokenizer::getVocab(const ov::Tensor& vocab,
+                                                                 const ov::Tensor& merges) const {
+    const bool isConstant = ov::as_type_ptr<ov::op::v0::Constant>(input_value(1).get_node_shared_ptr()) &&
+                            ov::as_type_ptr<ov::op::v0::Constant>(input_value(2).get_node_shared_ptr());
+    if (!isConstant)
+        return std::make_shared<Vocab>(vocab, merges);
+
+    std::lock_guard<std::mutex> lock(vocabMutex);
+    if (!constantVocab)
+        constantVocab = std::make_shared<Vocab>(vocab, merges);
+    return constantVocab;
+}
+
+bool BPETokenizer::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    ProfileScope scope(totalPhase);
+    const auto texts = openvino_extensions::detail::get_packed_strings_layout(inputs[0]);
+    const std::shared_ptr<const Vocab> vocab = getVocab(inputs[1], inputs[2]);
+    const size_t batch = texts.batch_size;
+
+    // Every symbol takes at least one byte of a text, so a text has no more ids than bytes
+    ScratchBuffer<size_t> idsBegin(scratchStats, batch + 1);
+    idsBegin[0] = 0;
+    for (size_t b = 0; b < batch; ++b) {
+        const size_t textSize = texts.get_end(b) - texts.get_begin(b);
+        OPENVINO_ASSERT(textSize <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                        "BPETokenizer text is too long");
+        const size_t maxIds = max_length > 0 ? std::min(textSize, static_cast<size_t>(max_length)) : textSize;
+        idsBegin[b + 1] = idsBegin[b] + maxIds;
+    }
+    ScratchBuffer<int64_t> ids(scratchStats, idsBegin[batch]);
+    ScratchBuffer<size_t> numIds(scratchStats, batch);
+
+    // Every text is tokenized by a separate task
+    parallelFor(opThreads, batch, [&](size_t b) {
+        const char* text = texts.symbols + texts.get_begin(b);
+        const char* textEnd = texts.symbols + texts.get_end(b);
+        const size_t maxIds = idsBegin[b + 1] - idsBegin[b];
+        WordScratch scratch(textEnd - text, end_of_word_suffix.size());
+        numIds[b] = 0;
+        for (const char* word = text; word < textEnd && numIds[b] < maxIds;) {
+            word = std::find_if_not(word, textEnd, isSpace);
+            const char* wordEnd = std::find_if(word, textEnd, isSpace);
+            if (word < wordEnd) {
+                vocab->tokenizeWord(word, wordEnd, end_of_word_suffix, scratch, unk_token_id,
+                                    ids.data() + idsBegin[b], numIds[b], maxIds);
+            }
+            word = wordEnd;
+        }
+    });
+
+    size_t length = static_cast<size_t>(max_length);
+    if (max_length == 0) {
+        for (size_t b = 0; b < batch; ++b)
+            length = std::max(length, numIds[b]);
+    }
+    outputs[0].set_shape({batch, length});
+    outputs[1].set_shape({batch, length});
+    int64_t* inputIds = outputs[0].data<int64_t>();
+    int64_t* attentionMask = outputs[1].data<int64_t>();
+    parallelFor(opThreads, batch, [&](size_t b) {
+        const size_t size = numIds[b];
+        std::copy(ids.data() + idsBegin[b], ids.data() + idsBegin[b] + size, inputIds + b * length);
+        std::fill(inputIds + b * length + size, inputIds + (b + 1) * length, pad_token_id);
+        std::fill(attentionMask + b * length, attentionMask + b * length + size, 1);
+        std::fill(attentionMask + b * length + size, attentionMask + (b + 1) * length, 0);
+    });
+    return true;
+}
+
+bool BPETokenizer::has_evaluate() const {
+    for (size_t i = 0; i < get_input_size(); ++i)
+        if (get_input_element_type(i) != ov::element::u8)
+            return false;
+    return true;
+}
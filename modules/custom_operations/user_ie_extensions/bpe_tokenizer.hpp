@@ -0,0 +1,50 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Byte pair encoding of a batch of texts. Inputs are packed string tensors (see openvino_extensions/strings.hpp):
+// texts, vocabulary where an index of a token is its id, and merges "left right" ordered by priority.
+// Outputs are input_ids and attention_mask of shape [batch, length] padded by pad_token_id and zeros.
+class BPETokenizer : public ov::op::Op {
+public:
+    OPENVINO_OP("BPETokenizer");
+
+    BPETokenizer() = default;
+    BPETokenizer(const ov::OutputVector& args,
+                 int64_t max_length = 0,
+                 int64_t pad_token_id = 0,
+                 int64_t unk_token_id = -1,
+                 const std::string& end_of_word_suffix = "");
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    // Length of outputs. Longer sequences are truncated. 0 pads to the longest sequence of a batch.
+    int64_t max_length = 0;
+    int64_t pad_token_id = 0;
+    // Id of symbols which are not in the vocabulary. Negative value drops them.
+    int64_t unk_token_id = -1;
+    // Appended to the last symbol of every word, e.g. "</w>"
+    std::string end_of_word_suffix;
+
+    // Hash maps of tokens and merges. They are built once if vocabulary and merges are constants.
+    struct Vocab;
+    std::shared_ptr<const Vocab> getVocab(const ov::Tensor& vocab, const ov::Tensor& merges) const;
+    mutable std::shared_ptr<const Vocab> constantVocab;
+    mutable std::mutex vocabMutex;
+};
+
+}  // namespace TemplateExtension
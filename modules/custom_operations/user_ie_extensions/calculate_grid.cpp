@@ -4,62 +4,310 @@
 
 #include "calculate_grid.hpp"
 
+#include <array>
+
+#include <openvino/core/parallel.hpp>
+
+#include "morton_code.hpp"
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "row_splits.hpp"
+#include "scratch_arena.hpp"
+
 using namespace TemplateExtension;
 
-CalculateGrid::CalculateGrid(const ov::Output<ov::Node>& inp_pos) : Op({inp_pos}) {
-    constructor_validate_and_infer_types();
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("CalculateGrid");
+OpThreads& opThreads = getOpThreads("CalculateGrid");
+ProfilePhase& totalPhase = getProfilePhase("CalculateGrid", "total");
+// Voxels of points packed to keys
+ProfilePhase& keysPhase = getProfilePhase("CalculateGrid", "keys");
+// Sorting of keys or of voxels which do not fit keys
+ProfilePhase& sortPhase = getProfilePhase("CalculateGrid", "sort");
+// Removal of duplicates
+ProfilePhase& uniquePhase = getProfilePhase("CalculateGrid", "unique");
+
+// Number of bits per coordinate in a packed voxel key. The same number of bits fits a Morton code.
+const int keyCoordBits = mortonCoordBits;
+const int radixBits = 8;
+const size_t radixSize = size_t(1) << radixBits;
+// Minimal number of elements processed by a single thread
+const size_t pointsPerThread = 4096;
+
+int getNumThreads(size_t size) {
+    const size_t maxThreads = std::max<size_t>(1, size / pointsPerThread);
+    return static_cast<int>(std::min<size_t>(maxThreads, static_cast<size_t>(opThreads.getMaxThreads())));
 }
 
-void CalculateGrid::validate_and_infer_types() {
-    auto outShape = get_input_partial_shape(0);
-    set_output_type(0, get_input_element_type(0), outShape);
+// Every input coordinate c is shifted by -1 or 0 and only even non-negative results are kept.
+// Exactly one of c - 1 and c is even, so every point produces at most one voxel (x / 2, y / 2, z / 2).
+bool getVoxel(const float* pos, int64_t voxel[3]) {
+    for (size_t k = 0; k < 3; ++k) {
+        const int val = static_cast<int>(pos[k]);
+        if (val < 0)
+            return false;
+        voxel[k] = val / 2;
+    }
+    return true;
 }
 
-std::shared_ptr<ov::Node> CalculateGrid::clone_with_new_inputs(const ov::OutputVector& new_args) const {
-    OPENVINO_ASSERT(new_args.size() == 1, "Incorrect number of new arguments");
-    return std::make_shared<CalculateGrid>(new_args.at(0));
+// Packs a voxel into a key which preserves lexicographic order of (x, y, z) or into its Morton code
+uint64_t packKey(const int64_t voxel[3], bool morton) {
+    if (morton)
+        return encodeMorton(voxel[0], voxel[1], voxel[2]);
+    return (static_cast<uint64_t>(voxel[0]) << (2 * keyCoordBits)) |
+           (static_cast<uint64_t>(voxel[1]) << keyCoordBits) |
+           static_cast<uint64_t>(voxel[2]);
 }
 
-bool CalculateGrid::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
-    const float* inpPos = reinterpret_cast<float*>(inputs[0].data());
-    float* out = reinterpret_cast<float*>(outputs[0].data());
+void unpackKey(uint64_t key, bool morton, float* out) {
+    const uint64_t mask = (uint64_t(1) << keyCoordBits) - 1;
+    uint64_t voxel[3] = {(key >> (2 * keyCoordBits)) & mask, (key >> keyCoordBits) & mask, key & mask};
+    if (morton)
+        decodeMorton(key, voxel);
+    for (size_t k = 0; k < 3; ++k)
+        out[k] = 0.5f + 2 * static_cast<int>(voxel[k]);
+}
 
-    std::set<std::tuple<int, int, int> > outPos;
+// Exclusive prefix sum over per-thread counters. Returns a total sum.
+size_t prefixSum(size_t* counts, size_t size) {
+    size_t sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const size_t c = counts[i];
+        counts[i] = sum;
+        sum += c;
+    }
+    return sum;
+}
 
-    const size_t numPoints = inputs[0].get_shape()[0];
-    static const std::vector<std::vector<int> > filters {{-1, -1, -1}, {-1, -1, 0}, {-1, 0, -1},
-                                                         {-1, 0, 0}, {0, -1, -1}, {0, -1, 0},
-                                                         {0, 0, -1}, {0, 0, 0}};
+// LSD radix sort. Every thread builds a histogram of its chunk and then scatters the chunk
+// to the positions reserved for it, so every pass is stable and requires no synchronization.
+// Passes swap keys and buffer, so the result is returned by a pointer to one of them.
+uint64_t* radixSort(uint64_t* keys, uint64_t* buffer, size_t size, uint64_t maxKey) {
+    const int nthr = getNumThreads(size);
+    ScratchBuffer<size_t> offsets(scratchStats, radixSize * nthr);
 
-    std::vector<int> pos(3);
+    for (int shift = 0; shift < 64 && (maxKey >> shift) != 0; shift += radixBits) {
+        // Histograms are laid out as [digit][thread] so that a plain prefix sum gives scatter offsets
+        std::fill(offsets.data(), offsets.data() + offsets.size(), 0);
+        ov::parallel_nt(nthr, [&](const int ithr, const int nthr) {
+            size_t start = 0, end = 0;
+            ov::splitter(size, nthr, ithr, start, end);
+            for (size_t i = start; i < end; ++i)
+                offsets[((keys[i] >> shift) & (radixSize - 1)) * nthr + ithr] += 1;
+        });
+        prefixSum(offsets.data(), offsets.size());
+        ov::parallel_nt(nthr, [&](const int ithr, const int nthr) {
+            size_t start = 0, end = 0;
+            ov::splitter(size, nthr, ithr, start, end);
+            for (size_t i = start; i < end; ++i)
+                buffer[offsets[((keys[i] >> shift) & (radixSize - 1)) * nthr + ithr]++] = keys[i];
+        });
+        std::swap(keys, buffer);
+    }
+    return keys;
+}
+
+// Fallback for voxels which do not fit a packed key
+size_t calculateGridSorted(const float* inpPos, size_t numPoints, bool morton, float* out) {
+    ProfileScope scope(sortPhase);
+    ScratchBuffer<std::array<int64_t, 3>> voxels(scratchStats, numPoints);
+    size_t numVoxels = 0;
+    int64_t voxel[3];
     for (size_t i = 0; i < numPoints; ++i) {
-        for (size_t j = 0; j < filters.size(); ++j) {
-            bool isValid = true;
-            for (size_t k = 0; k < 3; ++k) {
-                int val = static_cast<int>(inpPos[i * 3 + k]) + filters[j][k];
-                if (val < 0 || val % 2) {
-                    isValid = false;
-                    break;
+        if (getVoxel(inpPos + i * 3, voxel))
+            voxels[numVoxels++] = {{voxel[0], voxel[1], voxel[2]}};
+    }
+    std::array<int64_t, 3>* voxelsEnd = voxels.data() + numVoxels;
+    if (morton) {
+        std::sort(voxels.data(), voxelsEnd, [](const std::array<int64_t, 3>& a, const std::array<int64_t, 3>& b) {
+            return mortonLess(a.data(), b.data());
+        });
+    } else {
+        std::sort(voxels.data(), voxelsEnd);
+    }
+    numVoxels = std::unique(voxels.data(), voxelsEnd) - voxels.data();
+    for (size_t i = 0; i < numVoxels; ++i) {
+        for (size_t k = 0; k < 3; ++k)
+            out[i * 3 + k] = 0.5f + 2 * voxels[i][k];
+    }
+    return numVoxels;
+}
+
+// Writes unique voxels of a cloud to out in lexicographic or Morton order. Returns a number of voxels.
+size_t calculateGrid(const float* inpPos, size_t numPoints, bool morton, float* out) {
+    const int nthr = getNumThreads(numPoints);
+
+    // Collect packed keys of valid voxels. Every thread writes a contiguous part of keys.
+    ScratchBuffer<size_t> counts(scratchStats, nthr);
+    ScratchBuffer<uint64_t> maxKeys(scratchStats, nthr);
+    ScratchBuffer<char> fitsKey(scratchStats, nthr);
+    std::fill(counts.data(), counts.data() + nthr, 0);
+    std::fill(maxKeys.data(), maxKeys.data() + nthr, 0);
+    std::fill(fitsKey.data(), fitsKey.data() + nthr, true);
+    {
+        ProfileScope scope(keysPhase);
+        ov::parallel_nt(nthr, [&](const int ithr, const int nthr) {
+            size_t start = 0, end = 0;
+            ov::splitter(numPoints, nthr, ithr, start, end);
+            int64_t voxel[3];
+            for (size_t i = start; i < end; ++i) {
+                if (!getVoxel(inpPos + i * 3, voxel))
+                    continue;
+                counts[ithr] += 1;
+                if (std::max(std::max(voxel[0], voxel[1]), voxel[2]) >> keyCoordBits)
+                    fitsKey[ithr] = false;
+            }
+        });
+    }
+
+    size_t numOutPoints = 0;
+    if (std::find(fitsKey.data(), fitsKey.data() + nthr, false) != fitsKey.data() + nthr) {
+        numOutPoints = calculateGridSorted(inpPos, numPoints, morton, out);
+    } else {
+        const size_t numKeys = prefixSum(counts.data(), nthr);
+        ScratchBuffer<uint64_t> keysBuffer(scratchStats, numKeys);
+        ScratchBuffer<uint64_t> sortBuffer(scratchStats, numKeys);
+        uint64_t* keys = keysBuffer.data();
+        {
+            ProfileScope scope(keysPhase);
+            ov::parallel_nt(nthr, [&](const int ithr, const int nthr) {
+                size_t start = 0, end = 0;
+                ov::splitter(numPoints, nthr, ithr, start, end);
+                int64_t voxel[3];
+                size_t dst = counts[ithr];
+                for (size_t i = start; i < end; ++i) {
+                    if (!getVoxel(inpPos + i * 3, voxel))
+                        continue;
+                    keys[dst] = packKey(voxel, morton);
+                    maxKeys[ithr] = std::max(maxKeys[ithr], keys[dst]);
+                    dst += 1;
                 }
-                pos[k] = val;
+            });
+        }
+        {
+            ProfileScope scope(sortPhase);
+            keys = radixSort(keys, sortBuffer.data(), numKeys,
+                             *std::max_element(maxKeys.data(), maxKeys.data() + nthr));
+        }
+
+        // Remove duplicates. Every thread counts first occurrences of keys in its chunk and then writes them.
+        ProfileScope scope(uniquePhase);
+        const int nthrUnique = getNumThreads(numKeys);
+        ScratchBuffer<size_t> uniqueCounts(scratchStats, nthrUnique);
+        std::fill(uniqueCounts.data(), uniqueCounts.data() + nthrUnique, 0);
+        ov::parallel_nt(nthrUnique, [&](const int ithr, const int nthr) {
+            size_t start = 0, end = 0;
+            ov::splitter(numKeys, nthr, ithr, start, end);
+            for (size_t i = start; i < end; ++i)
+                uniqueCounts[ithr] += (i == 0 || keys[i] != keys[i - 1]);
+        });
+        numOutPoints = prefixSum(uniqueCounts.data(), nthrUnique);
+        ov::parallel_nt(nthrUnique, [&](const int ithr, const int nthr) {
+            size_t start = 0, end = 0;
+            ov::splitter(numKeys, nthr, ithr, start, end);
+            size_t dst = uniqueCounts[ithr];
+            for (size_t i = start; i < end; ++i) {
+                if (i == 0 || keys[i] != keys[i - 1])
+                    unpackKey(keys[i], morton, out + 3 * dst++);
             }
-            if (isValid)
-                outPos.insert(std::make_tuple(pos[0], pos[1], pos[2]));
+        });
+    }
+
+    return numOutPoints;
+}
+
+bool isMortonOrder(const std::string& order) {
+    if (order == "lexicographic")
+        return false;
+    if (order == "morton")
+        return true;
+    OPENVINO_THROW("Unsupported CalculateGrid order: " + order);
+}
+
+}  // namespace
+
+CalculateGrid::CalculateGrid(const ov::Output<ov::Node>& inp_pos, const std::string& order)
+    : Op({inp_pos}), order(order) {
+    constructor_validate_and_infer_types();
+}
+
+CalculateGrid::CalculateGrid(const ov::OutputVector& args, const std::string& order) : Op(args), order(order) {
+    constructor_validate_and_infer_types();
+}
+
+void CalculateGrid::validate_and_infer_types() {
+    isMortonOrder(order);
+    OPENVINO_ASSERT(get_input_size() == 1 || get_input_size() == 2,
+                    "CalculateGrid expects positions and optional row splits inputs");
+    if (get_input_size() == 1) {
+        auto outShape = get_input_partial_shape(0);
+        set_output_type(0, get_input_element_type(0), outShape);
+        return;
+    }
+
+    // A number of voxels is known only after evaluation
+    set_output_type(0, get_input_element_type(0), ov::PartialShape{ov::Dimension::dynamic(), 3});
+    set_output_type(1, get_input_element_type(1), get_input_partial_shape(1));
+}
+
+std::shared_ptr<ov::Node> CalculateGrid::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 1 || new_args.size() == 2, "Incorrect number of new arguments");
+    return std::make_shared<CalculateGrid>(new_args, order);
+}
+
+bool CalculateGrid::visit_attributes(ov::AttributeVisitor& visitor) {
+    visitor.on_attribute("order", order);
+    return true;
+}
+
+bool CalculateGrid::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    ProfileScope scope(totalPhase);
+    const bool morton = isMortonOrder(order);
+    const float* inpPos = inputs[0].data<float>();
+    const size_t numPoints = inputs[0].get_shape()[0];
+
+    if (inputs.size() == 1) {
+        float* out = outputs[0].data<float>();
+        const size_t numOutPoints = calculateGrid(inpPos, numPoints, morton, out);
+
+        // Unused part of output is filled by zeros and the first unused point is marked by -1
+        if (numOutPoints < numPoints) {
+            memset(out + numOutPoints * 3, 0, sizeof(float) * 3 * (numPoints - numOutPoints));
+            out[numOutPoints * 3] = -1.0f;
         }
+        return true;
+    }
+
+    // Voxels of every cloud are written at the offset of its points, so they fit and then are compacted
+    const size_t numClouds = getNumClouds(inputs[1]);
+    ScratchBuffer<size_t> splits(scratchStats, numClouds + 1);
+    readRowSplits(inputs[1], numPoints, splits.data());
+    ScratchBuffer<float> voxels(scratchStats, numPoints * 3);
+    ScratchBuffer<size_t> outSplits(scratchStats, numClouds + 1);
+    outSplits[0] = 0;
+    for (size_t c = 0; c < numClouds; ++c) {
+        outSplits[c + 1] = outSplits[c] + calculateGrid(inpPos + splits[c] * 3, splits[c + 1] - splits[c], morton,
+                                                        voxels.data() + splits[c] * 3);
     }
 
-    int i = 0;
-    for (const auto& it : outPos) {
-        out[i * 3] = 0.5f + std::get<0>(it);
-        out[i * 3 + 1] = 0.5f + std::get<1>(it);
-        out[i * 3 + 2] = 0.5f + std::get<2>(it);
-        i += 1;
+    outputs[0].set_shape({outSplits[numClouds], 3});
+    outputs[1].set_shape({numClouds + 1});
+    float* out = outputs[0].data<float>();
+    parallelFor(opThreads, numClouds, [&](size_t c) {
+        std::copy_n(voxels.data() + splits[c] * 3, (outSplits[c + 1] - outSplits[c]) * 3, out + outSplits[c] * 3);
+    });
+    for (size_t c = 0; c <= numClouds; ++c) {
+        if (outputs[1].get_element_type() == ov::element::i32)
+            outputs[1].data<int32_t>()[c] = static_cast<int32_t>(outSplits[c]);
+        else
+            outputs[1].data<int64_t>()[c] = static_cast<int64_t>(outSplits[c]);
     }
-    memset(out + i * 3, 0, sizeof(float) * 3 * (numPoints - i));
-    out[i * 3] = -1.0f;
     return true;
 }
 
 bool CalculateGrid::has_evaluate() const {
-    return get_input_element_type(0) == ov::element::f32 ? true : false;
+    return get_input_element_type(0) == ov::element::f32 &&
+           (get_input_size() == 1 || isRowSplitsType(get_input_element_type(1)));
 }
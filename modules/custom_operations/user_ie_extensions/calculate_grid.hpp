@@ -4,21 +4,34 @@
 
 #pragma once
 
+#include <string>
+
 #include <openvino/op/op.hpp>
 
 namespace TemplateExtension {
 
+// Computes unique voxels of a grid of twice larger cells. With a single input of positions the output has the same
+// shape, and unused points are zeros terminated by -1. With row splits of a batch of clouds the outputs are
+// voxels of all the clouds [M, 3] and their row splits.
+// Voxels of every cloud are sorted lexicographically by (x, y, z) or in Z-order of their Morton codes. The latter
+// keeps neighbors close in memory for the following sparse convolutions.
 class CalculateGrid : public ov::op::Op {
 public:
     OPENVINO_OP("CalculateGrid");
 
     CalculateGrid() = default;
-    CalculateGrid(const ov::Output<ov::Node>& inp_pos);
+    CalculateGrid(const ov::Output<ov::Node>& inp_pos, const std::string& order = "lexicographic");
+    CalculateGrid(const ov::OutputVector& args, const std::string& order = "lexicographic");
     void validate_and_infer_types() override;
     std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
 
     bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
     bool has_evaluate() const override;
+
+private:
+    // Order of output voxels: lexicographic or morton
+    std::string order = "lexicographic";
 };
 
 }  // namespace TemplateExtension
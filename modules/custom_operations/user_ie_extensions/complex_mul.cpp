@@ -5,14 +5,249 @@
 #include "complex_mul.hpp"
 #include <openvino/core/parallel.hpp>
 
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "reduced_precision.hpp"
+#include "scratch_arena.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define COMPLEX_MUL_X86
+#    include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#    define COMPLEX_MUL_NEON
+#    include <arm_neon.h>
+#endif
+
 using namespace TemplateExtension;
 
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("ComplexMultiplication");
+OpThreads& opThreads = getOpThreads("ComplexMultiplication");
+ProfilePhase& totalPhase = getProfilePhase("ComplexMultiplication", "total");
+
+// Number of complex elements of an innermost row processed by a single task
+const size_t rowChunk = 2048;
+
+// Multiplies n interleaved complex numbers: out[i] = a[i] * b[i], or out[i] = a[i] * b[0] for a scalar b
+using ComplexMulKernel = void (*)(const float* a, const float* b, float* out, size_t n);
+
+// x1 = x_r * y_r - x_i * y_i
+// x2 = x_r * y_i + x_i * y_r
+template <bool scalarB>
+void complexMulRef(const float* a, const float* b, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = scalarB ? 0 : i;
+        const float real0 = a[2 * i];
+        const float imag0 = a[2 * i + 1];
+        const float real1 = b[2 * j];
+        const float imag1 = b[2 * j + 1];
+        out[2 * i] = real0 * real1 - imag0 * imag1;
+        out[2 * i + 1] = real0 * imag1 + imag0 * real1;
+    }
+}
+
+#ifdef COMPLEX_MUL_X86
+// Real and imaginary parts of b are duplicated to even and odd lanes and real and imaginary parts of a
+// are swapped. Then fmaddsub gives a_r * b_r - a_i * b_i in even lanes and a_i * b_r + a_r * b_i in odd lanes.
+template <bool scalarB>
+__attribute__((target("avx2,fma"))) void complexMulAVX2(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    __m256 bRe = _mm256_set1_ps(scalarB ? b[0] : 0.0f);
+    __m256 bIm = _mm256_set1_ps(scalarB ? b[1] : 0.0f);
+    for (; i + 4 <= n; i += 4) {
+        const __m256 va = _mm256_loadu_ps(a + 2 * i);
+        if (!scalarB) {
+            const __m256 vb = _mm256_loadu_ps(b + 2 * i);
+            bRe = _mm256_shuffle_ps(vb, vb, 0xA0);
+            bIm = _mm256_shuffle_ps(vb, vb, 0xF5);
+        }
+        const __m256 aSwap = _mm256_shuffle_ps(va, va, 0xB1);
+        _mm256_storeu_ps(out + 2 * i, _mm256_fmaddsub_ps(va, bRe, _mm256_mul_ps(aSwap, bIm)));
+    }
+    complexMulRef<scalarB>(a + 2 * i, scalarB ? b : b + 2 * i, out + 2 * i, n - i);
+}
+
+template <bool scalarB>
+__attribute__((target("avx512f"))) void complexMulAVX512(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    __m512 bRe = _mm512_set1_ps(scalarB ? b[0] : 0.0f);
+    __m512 bIm = _mm512_set1_ps(scalarB ? b[1] : 0.0f);
+    for (; i + 8 <= n; i += 8) {
+        const __m512 va = _mm512_loadu_ps(a + 2 * i);
+        if (!scalarB) {
+            const __m512 vb = _mm512_loadu_ps(b + 2 * i);
+            bRe = _mm512_shuffle_ps(vb, vb, 0xA0);
+            bIm = _mm512_shuffle_ps(vb, vb, 0xF5);
+        }
+        const __m512 aSwap = _mm512_shuffle_ps(va, va, 0xB1);
+        _mm512_storeu_ps(out + 2 * i, _mm512_fmaddsub_ps(va, bRe, _mm512_mul_ps(aSwap, bIm)));
+    }
+    complexMulAVX2<scalarB>(a + 2 * i, scalarB ? b : b + 2 * i, out + 2 * i, n - i);
+}
+#endif
+
+#ifdef COMPLEX_MUL_NEON
+// Structure loads deinterleave real and imaginary parts into separate registers and structure stores
+// interleave them back
+template <bool scalarB>
+void complexMulNEON(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    float32x4_t bRe = vdupq_n_f32(scalarB ? b[0] : 0.0f);
+    float32x4_t bIm = vdupq_n_f32(scalarB ? b[1] : 0.0f);
+    for (; i + 4 <= n; i += 4) {
+        const float32x4x2_t va = vld2q_f32(a + 2 * i);
+        if (!scalarB) {
+            const float32x4x2_t vb = vld2q_f32(b + 2 * i);
+            bRe = vb.val[0];
+            bIm = vb.val[1];
+        }
+        float32x4x2_t res;
+        res.val[0] = vmlsq_f32(vmulq_f32(va.val[0], bRe), va.val[1], bIm);
+        res.val[1] = vmlaq_f32(vmulq_f32(va.val[0], bIm), va.val[1], bRe);
+        vst2q_f32(out + 2 * i, res);
+    }
+    complexMulRef<scalarB>(a + 2 * i, scalarB ? b : b + 2 * i, out + 2 * i, n - i);
+}
+#endif
+
+struct ComplexMulKernels {
+    ComplexMulKernel mul;
+    ComplexMulKernel mulScalar;
+};
+
+// Kernels are selected once for the instruction set of the host CPU
+const ComplexMulKernels& getKernels() {
+    static const ComplexMulKernels kernels = []() -> ComplexMulKernels {
+#if defined(COMPLEX_MUL_X86)
+        if (__builtin_cpu_supports("avx512f"))
+            return {complexMulAVX512<false>, complexMulAVX512<true>};
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {complexMulAVX2<false>, complexMulAVX2<true>};
+#elif defined(COMPLEX_MUL_NEON)
+        return {complexMulNEON<false>, complexMulNEON<true>};
+#endif
+        return {complexMulRef<false>, complexMulRef<true>};
+    }();
+    return kernels;
+}
+
+// Multiplies a chunk of a row where scalarA or scalarB means that the input is broadcasted along the row
+void mulRow(const ComplexMulKernels& kernels, const float* a, const float* b, float* dst, size_t n, bool scalarA,
+            bool scalarB) {
+    // Innermost dimension can be broadcasted for one of the inputs only. Multiplication is commutative.
+    if (scalarB)
+        kernels.mulScalar(a, b, dst, n);
+    else if (scalarA)
+        kernels.mulScalar(b, a, dst, n);
+    else
+        kernels.mul(a, b, dst, n);
+}
+
+// Reduced precision chunks are converted to f32 in scratch buffers which stay in cache
+template <typename T>
+void mulRow(const ComplexMulKernels& kernels, const T* a, const T* b, T* dst, size_t n, bool scalarA, bool scalarB) {
+    const size_t sizeA = scalarA ? 2 : 2 * n;
+    const size_t sizeB = scalarB ? 2 : 2 * n;
+    ScratchBuffer<float> a32(scratchStats, sizeA);
+    ScratchBuffer<float> b32(scratchStats, sizeB);
+    ScratchBuffer<float> dst32(scratchStats, 2 * n);
+    convertToFloat(a, a32.data(), sizeA);
+    convertToFloat(b, b32.data(), sizeB);
+    mulRow(kernels, a32.data(), b32.data(), dst32.data(), n, scalarA, scalarB);
+    convertFromFloat(dst32.data(), dst, 2 * n);
+}
+
+// Output dimension with strides of both inputs in complex elements. Broadcasted inputs have zero strides.
+struct BroadcastDim {
+    size_t size, stride0, stride1;
+};
+
+// Returns broadcasted dimensions from the innermost to the outermost one. Unit dimensions are dropped and
+// neighboring dimensions which are traversed uniformly by both inputs are merged, so the innermost
+// dimension has strides 0 or 1 and its rows can be processed by vectorized kernels.
+std::vector<BroadcastDim> getBroadcastDims(const ov::Shape& shape0, const ov::Shape& shape1, const ov::Shape& outShape) {
+    std::vector<BroadcastDim> dims;
+    size_t stride0 = 1, stride1 = 1;
+    // The last dimension keeps real and imaginary parts
+    for (size_t i = 1; i < outShape.size(); ++i) {
+        const size_t size = outShape[outShape.size() - 1 - i];
+        const size_t dim0 = i < shape0.size() ? shape0[shape0.size() - 1 - i] : 1;
+        const size_t dim1 = i < shape1.size() ? shape1[shape1.size() - 1 - i] : 1;
+        const BroadcastDim dim{size, dim0 == 1 ? 0 : stride0, dim1 == 1 ? 0 : stride1};
+        stride0 *= dim0;
+        stride1 *= dim1;
+        if (size == 1)
+            continue;
+
+        if (!dims.empty()) {
+            BroadcastDim& prev = dims.back();
+            const bool uniform0 = dim.stride0 == prev.stride0 * prev.size;
+            const bool uniform1 = dim.stride1 == prev.stride1 * prev.size;
+            if (uniform0 && uniform1) {
+                prev.size *= size;
+                continue;
+            }
+        }
+        dims.push_back(dim);
+    }
+    if (dims.empty())
+        dims.push_back({1, 1, 1});
+    return dims;
+}
+
+ov::Shape getBroadcastShape(const ov::Shape& shape0, const ov::Shape& shape1) {
+    ov::Shape outShape(std::max(shape0.size(), shape1.size()), 1);
+    for (size_t i = 0; i < outShape.size(); ++i) {
+        const size_t dim0 = i < shape0.size() ? shape0[shape0.size() - 1 - i] : 1;
+        const size_t dim1 = i < shape1.size() ? shape1[shape1.size() - 1 - i] : 1;
+        if (dim0 != dim1 && dim0 != 1 && dim1 != 1)
+            OPENVINO_THROW("ComplexMultiplication inputs are not broadcastable");
+        outShape[outShape.size() - 1 - i] = std::max(dim0, dim1);
+    }
+    return outShape;
+}
+
+template <typename T>
+void complexMul(ov::Tensor& output, const ov::Tensor& input0, const ov::Tensor& input1,
+                const std::vector<BroadcastDim>& dims) {
+    const T* inp0 = input0.data<T>();
+    const T* inp1 = input1.data<T>();
+    T* out = output.data<T>();
+
+    const BroadcastDim& inner = dims[0];
+    const size_t numRows = output.get_size() / 2 / inner.size;
+    const size_t numChunks = (inner.size + rowChunk - 1) / rowChunk;
+    const ComplexMulKernels& kernels = getKernels();
+
+    parallelFor(opThreads, numRows * numChunks, [&](size_t d) {
+        const size_t row = d / numChunks;
+        const size_t begin = (d % numChunks) * rowChunk;
+        const size_t n = std::min(rowChunk, inner.size - begin);
+
+        size_t offset0 = begin * inner.stride0, offset1 = begin * inner.stride1;
+        for (size_t i = 1, idx = row; i < dims.size(); ++i) {
+            offset0 += (idx % dims[i].size) * dims[i].stride0;
+            offset1 += (idx % dims[i].size) * dims[i].stride1;
+            idx /= dims[i].size;
+        }
+
+        mulRow(kernels, inp0 + 2 * offset0, inp1 + 2 * offset1, out + 2 * (row * inner.size + begin), n,
+               inner.stride0 == 0, inner.stride1 == 0);
+    });
+}
+
+}  // namespace
+
 ComplexMultiplication::ComplexMultiplication(const ov::OutputVector& args) : Op(args) {
     constructor_validate_and_infer_types();
 }
 
 void ComplexMultiplication::validate_and_infer_types() {
     auto outShape = get_input_partial_shape(0);
+    OPENVINO_ASSERT(ov::PartialShape::broadcast_merge_into(outShape, get_input_partial_shape(1),
+                                                           ov::op::AutoBroadcastType::NUMPY),
+                    "ComplexMultiplication inputs are not broadcastable");
     set_output_type(0, get_input_element_type(1), outShape);
 }
 
@@ -22,52 +257,35 @@ std::shared_ptr<ov::Node> ComplexMultiplication::clone_with_new_inputs(const ov:
 }
 
 bool ComplexMultiplication::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
-    const float* inp0 = reinterpret_cast<float*>(inputs[0].data());
-    const float* inp1 = reinterpret_cast<float*>(inputs[1].data());
-    float* out = reinterpret_cast<float*>(outputs[0].data());
-
-    size_t channels0 = inputs[0].get_shape()[1];
-    size_t channels1 = inputs[1].get_shape()[1];
-    size_t batch = inputs[0].get_shape()[0];
-    size_t spatialSize = inputs[0].get_shape()[2] * inputs[0].get_shape()[3];
-
-    // x1 = x_r * y_r - x_i * y_i
-    // x2 = x_r * y_i + x_i * y_r
-    if (channels0 == channels1)
-        ov::parallel_for(channels0 * batch, [&](size_t ch) {
-            for (size_t i = 0; i < spatialSize; ++i) {
-                    size_t outIdx = (ch * spatialSize + i) * 2;
-                    float real0 = inp0[outIdx];
-                    float imag0 = inp0[outIdx + 1];
-                    float real1 = inp1[outIdx];
-                    float imag1 = inp1[outIdx + 1];
-                    out[outIdx] = real0 * real1 - imag0 * imag1;
-                    out[outIdx + 1] = real0 * imag1 + imag0 * real1;
-            }
-        });
-    else if (channels1 == 1)
-        ov::parallel_for(channels0 * batch, [&](size_t ch) {
-            size_t b = ch / channels0;
-            for (size_t i = 0; i < spatialSize; ++i) {
-                size_t outIdx = (ch * spatialSize + i) * 2;
-                size_t inpIdx = (b * spatialSize + i) * 2;
-                float real0 = inp0[outIdx];
-                float imag0 = inp0[outIdx + 1];
-                float real1 = inp1[inpIdx];
-                float imag1 = inp1[inpIdx + 1];
-                out[outIdx] = real0 * real1 - imag0 * imag1;
-                out[outIdx + 1] = real0 * imag1 + imag0 * real1;
-            }
-        });
-    else
-        OPENVINO_THROW("Wrong number of channels for second input!");
+    const ov::Shape& shape0 = inputs[0].get_shape();
+    const ov::Shape& shape1 = inputs[1].get_shape();
+    OPENVINO_ASSERT(!shape0.empty() && shape0.back() == 2 && !shape1.empty() && shape1.back() == 2,
+                    "ComplexMultiplication expects the last dimension of inputs to be 2");
+    const ov::Shape outShape = getBroadcastShape(shape0, shape1);
+    outputs[0].set_shape(outShape);
 
+    const std::vector<BroadcastDim> dims = getBroadcastDims(shape0, shape1, outShape);
+    ProfileScope scope(totalPhase);
+    switch (inputs[0].get_element_type()) {
+    case ov::element::f32:
+        complexMul<float>(outputs[0], inputs[0], inputs[1], dims);
+        break;
+    case ov::element::f16:
+        complexMul<ov::float16>(outputs[0], inputs[0], inputs[1], dims);
+        break;
+    case ov::element::bf16:
+        complexMul<ov::bfloat16>(outputs[0], inputs[0], inputs[1], dims);
+        break;
+    default:
+        OPENVINO_THROW("Unexpected inputs type: " + inputs[0].get_element_type().to_string());
+    }
     return true;
 }
 
 bool ComplexMultiplication::has_evaluate() const {
+    // Both inputs are f32, f16 or bf16 of the same type
     for (size_t i = 0; i < get_input_size(); ++i)
-        if (get_input_element_type(i) != ov::element::f32)
+        if (get_input_element_type(i) != get_input_element_type(0))
             return false;
-    return true;
+    return isEvaluatedFloatType(get_input_element_type(0));
 }
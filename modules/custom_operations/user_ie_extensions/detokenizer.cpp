@@ -0,0 +1,188 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "detokenizer.hpp"
+
+#include <algorithm>
+
+#include <openvino/core/parallel.hpp>
+#include <openvino/op/constant.hpp>
+
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "openvino_extensions/strings.hpp"
+
+using namespace TemplateExtension;
+
+namespace {
+
+ProfilePhase& totalPhase = getProfilePhase("Detokenizer", "total");
+OpThreads& opThreads = getOpThreads("Detokenizer");
+
+template <typename T>
+int64_t getTokenId(const void* ids, size_t i) {
+    return static_cast<const T*>(ids)[i];
+}
+
+// Writes a header and offsets of a packed string tensor for the given lengths of strings
+template <typename Offset>
+void packOffsets(const std::vector<size_t>& lengths, uint8_t* data, size_t headerSize) {
+    Offset* offsets = reinterpret_cast<Offset*>(data + headerSize);
+    offsets[0] = 0;
+    for (size_t b = 0; b < lengths.size(); ++b)
+        offsets[b + 1] = static_cast<Offset>(offsets[b] + lengths[b]);
+}
+
+}  // namespace
+
+struct Detokenizer::Vocab {
+    // Token i consists of symbols[offsets[i]:offsets[i + 1]]
+    std::string symbols;
+    std::vector<size_t> offsets;
+
+    Vocab(const ov::Tensor& vocab, const std::string& suffix) {
+        const auto layout = openvino_extensions::detail::get_packed_strings_layout(vocab);
+        if (layout.batch_size)
+            symbols.reserve(layout.get_end(layout.batch_size - 1) - layout.get_begin(0));
+        offsets.resize(layout.batch_size + 1, 0);
+        for (size_t i = 0; i < layout.batch_size; ++i) {
+            const char* begin = layout.symbols + layout.get_begin(i);
+            const char* end = layout.symbols + layout.get_end(i);
+            const size_t length = end - begin;
+            if (!suffix.empty() && length >= suffix.size() &&
+                std::equal(suffix.begin(), suffix.end(), end - suffix.size())) {
+                symbols.append(begin, end - suffix.size());
+                symbols += ' ';
+            } else {
+                symbols.append(begin, end);
+            }
+            offsets[i + 1] = symbols.size();
+        }
+    }
+
+    size_t size() const {
+        return offsets.size() - 1;
+    }
+};
+
+Detokenizer::Detokenizer(const ov::OutputVector& args, int64_t pad_token_id, const std::string& end_of_word_suffix)
+    : Op(args),
+      pad_token_id(pad_token_id),
+      end_of_word_suffix(end_of_word_suffix) {
+    constructor_validate_and_infer_types();
+}
+
+void Detokenizer::validate_and_infer_types() {
+    OPENVINO_ASSERT(get_input_size() == 2, "Detokenizer expects token ids and vocabulary inputs");
+    const auto idsType = get_input_element_type(0);
+    OPENVINO_ASSERT(idsType == ov::element::i32 || idsType == ov::element::i64 || idsType.is_dynamic(),
+                    "Detokenizer expects token ids with i32 or i64 element type");
+    const auto idsRank = get_input_partial_shape(0).rank();
+    OPENVINO_ASSERT(idsRank.is_dynamic() || idsRank.get_length() == 2, "Detokenizer expects token ids of rank 2");
+    OPENVINO_ASSERT(get_input_element_type(1) == ov::element::u8,
+                    "Detokenizer expects a packed string tensor of vocabulary with u8 element type");
+
+    // Size of the output depends on the lengths of the texts
+    set_output_type(0, ov::element::u8, ov::PartialShape{ov::Dimension::dynamic()});
+
+    // Inputs might be changed
+    std::lock_guard<std::mutex> lock(vocabMutex);
+    constantVocab.reset();
+}
+
+std::shared_ptr<ov::Node> Detokenizer::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
+    return std::make_shared<Detokenizer>(new_args, pad_token_id, end_of_word_suffix);
+}
+
+bool Detokenizer::visit_attributes(ov::AttributeVisitor& visitor) {
+    visitor.on_attribute("pad_token_id", pad_token_id);
+    visitor.on_attribute("end_of_word_suffix", end_of_word_suffix);
+    return true;
+}
+
+std::shared_ptr<const Detokenizer::Vocab> Detokenizer::getVocab(const ov::Tensor& vocab) const {
+    if (!ov::as_type_ptr<ov::op::v0::Constant>(input_value(1).get_node_shared_ptr()))
+        return std::make_shared<Vocab>(vocab, end_of_word_suffix);
+
+    std::lock_guard<std::mutex> lock(vocabMutex);
+    if (!constantVocab)
+        constantVocab = std::make_shared<Vocab>(vocab, end_of_word_suffix);
+    return constantVocab;
+}
+
+bool Detokenizer::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    using namespace openvino_extensions;
+
+    ProfileScope scope(totalPhase);
+    const std::shared_ptr<const Vocab> vocab = getVocab(inputs[1]);
+    const ov::Shape& idsShape = inputs[0].get_shape();
+    const size_t batch = idsShape[0];
+    const size_t length = idsShape[1];
+    const void* ids = inputs[0].data();
+    int64_t (*getId)(const void*, size_t) =
+        inputs[0].get_element_type() == ov::element::i32 ? getTokenId<int32_t> : getTokenId<int64_t>;
+    const int64_t vocabSize = static_cast<int64_t>(vocab->size());
+    const size_t* offsets = vocab->offsets.data();
+    auto isSkipped = [&](int64_t id) {
+        return id < 0 || id >= vocabSize || id == pad_token_id;
+    };
+
+    // The first pass computes lengths of texts by the offsets table. Words are separated by spaces
+    // which replace the suffixes, so the trailing space of a text is dropped.
+    std::vector<size_t> lengths(batch, 0);
+    parallelFor(opThreads, batch, [&](size_t b) {
+        int64_t lastId = -1;
+        for (size_t i = 0; i < length; ++i) {
+            const int64_t id = getId(ids, b * length + i);
+            if (isSkipped(id))
+                continue;
+            lengths[b] += offsets[id + 1] - offsets[id];
+            lastId = id;
+        }
+        if (!end_of_word_suffix.empty() && lastId >= 0 && offsets[lastId + 1] > offsets[lastId] &&
+            vocab->symbols[offsets[lastId + 1] - 1] == ' ')
+            lengths[b] -= 1;
+    });
+
+    size_t symbolsSize = 0;
+    for (size_t len : lengths)
+        symbolsSize += len;
+    const auto format = detail::select_format(packed_strings_format::automatic, batch, symbolsSize);
+    const size_t headerSize = detail::get_header_size(format);
+    const size_t offsetsSize = detail::get_offset_size(format) * (batch + 1);
+    outputs[0].set_shape({headerSize + offsetsSize + symbolsSize});
+    uint8_t* data = outputs[0].data<uint8_t>();
+    if (format == packed_strings_format::offsets64) {
+        reinterpret_cast<int32_t*>(data)[0] = detail::packed_strings_offsets64_marker;
+        reinterpret_cast<int32_t*>(data)[1] = detail::packed_strings_offsets64_version;
+        reinterpret_cast<uint64_t*>(data)[1] = static_cast<uint64_t>(batch);
+        packOffsets<uint64_t>(lengths, data, headerSize);
+    } else {
+        reinterpret_cast<int32_t*>(data)[0] = static_cast<int32_t>(batch);
+        packOffsets<int32_t>(lengths, data, headerSize);
+    }
+
+    // The second pass gathers symbols of tokens. Every text starts at a known offset.
+    const auto layout = detail::get_packed_strings_layout(outputs[0]);
+    char* symbols = reinterpret_cast<char*>(data + headerSize + offsetsSize);
+    parallelFor(opThreads, batch, [&](size_t b) {
+        char* dst = symbols + layout.get_begin(b);
+        char* dstEnd = symbols + layout.get_end(b);
+        for (size_t i = 0; i < length && dst < dstEnd; ++i) {
+            const int64_t id = getId(ids, b * length + i);
+            if (isSkipped(id))
+                continue;
+            const size_t size = std::min<size_t>(offsets[id + 1] - offsets[id], dstEnd - dst);
+            dst = std::copy_n(vocab->symbols.data() + offsets[id], size, dst);
+        }
+    });
+    return true;
+}
+
+bool Detokenizer::has_evaluate() const {
+    const auto idsType = get_input_element_type(0);
+    return (idsType == ov::element::i32 || idsType == ov::element::i64) &&
+           get_input_element_type(1) == ov::element::u8;
+}
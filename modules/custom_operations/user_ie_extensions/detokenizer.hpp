@@ -0,0 +1,43 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Maps token ids of shape [batch, length] back to texts. The second input is a vocabulary packed string tensor
+// (see openvino_extensions/strings.hpp) where an index of a token is its id. The output is a packed string tensor
+// with a text per sequence. Ids which are out of the vocabulary and pad_token_id are skipped.
+class Detokenizer : public ov::op::Op {
+public:
+    OPENVINO_OP("Detokenizer");
+
+    Detokenizer() = default;
+    Detokenizer(const ov::OutputVector& args, int64_t pad_token_id = -1, const std::string& end_of_word_suffix = "");
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    // Negative value keeps all the ids of the vocabulary
+    int64_t pad_token_id = -1;
+    // Suffix of the last token of every word, e.g. "</w>". It is replaced by a space between words.
+    std::string end_of_word_suffix;
+
+    // Symbols of all the tokens and their byte offsets. It is built once if the vocabulary is a constant.
+    struct Vocab;
+    std::shared_ptr<const Vocab> getVocab(const ov::Tensor& vocab) const;
+    mutable std::shared_ptr<const Vocab> constantVocab;
+    mutable std::mutex vocabMutex;
+};
+
+}  // namespace TemplateExtension
@@ -4,301 +4,401 @@
 
 #include "fft.hpp"
 
+#include <functional>
+#include <numeric>
+#include <type_traits>
+
 #include <openvino/core/parallel.hpp>
-#include <opencv2/core/core_c.h>
+#include <openvino/op/constant.hpp>
+
+#include "fft_engine.hpp"
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "reduced_precision.hpp"
+#include "scratch_arena.hpp"
 
 using namespace TemplateExtension;
 
-void fftshift(CvMat* src, bool inverse) {
-    // tl | tr        br | bl
-    // ---+---   ->   ---+---
-    // bl | br        tr | tl
-
-    float* data;
-    int step;
-    CvSize size;
-    cvGetRawData(src, (uchar**)&data, &step, &size);
-
-    int height = size.height;
-    int width = size.width;
-    int h2 = height / 2;
-    int w2 = width / 2;
-
-    if (height % 2 || width % 2) {
-        // Swap rows.
-        CvMat* srcTop = new CvMat();
-        CvMat* srcBot = new CvMat();
-        CvMat* dstTop = new CvMat();
-        CvMat* dstBot = new CvMat();
-        int topH = inverse ? h2 : (h2 + height % 2);
-        int botH = height - topH;
-        cvInitMatHeader(srcTop, topH, width, CV_32FC2, data, step);
-        cvInitMatHeader(srcBot, botH, width, CV_32FC2, data + topH * width * 2, step);
-        cvInitMatHeader(dstTop, topH, width, CV_32FC2, data + botH * width * 2, step);
-        cvInitMatHeader(dstBot, botH, width, CV_32FC2, data, step);
-
-        CvMat* tmp = cvCloneMat(srcTop);
-        cvCopy(srcBot, dstBot, 0);
-        cvCopy(tmp, dstTop, 0);
-
-        cvReleaseMat(&tmp);
-        delete srcTop;
-        delete srcBot;
-        delete dstTop;
-        delete dstBot;
-
-        // Swap columns.
-        CvMat* srcL = new CvMat();
-        CvMat* srcR = new CvMat();
-        CvMat* dstL = new CvMat();
-        CvMat* dstR = new CvMat();
-        int leftW = inverse ? w2 : (w2 + width % 2);
-        int rightW = width - leftW;
-
-        cvInitMatHeader(srcL, height, leftW, CV_32FC2, data, step);
-        cvInitMatHeader(srcR, height, rightW, CV_32FC2, data + leftW * 2, step);
-        cvInitMatHeader(dstL, height, leftW, CV_32FC2, data + rightW * 2, step);
-        cvInitMatHeader(dstR, height, rightW, CV_32FC2, data, step);
-
-        tmp = cvCloneMat(srcL);
-        cvCopy(srcR, dstR, 0);
-        cvCopy(tmp, dstL, 0);
-
-        cvReleaseMat(&tmp);
-        delete srcL;
-        delete srcR;
-        delete dstL;
-        delete dstR;
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("FFT");
+OpThreads& opThreads = getOpThreads("FFT");
+ProfilePhase& totalPhase = getProfilePhase("FFT", "total");
+// Loads of lines along an axis with conversion of reduced precision and ifftshift of centered transforms
+ProfilePhase& gatherPhase = getProfilePhase("FFT", "gather");
+ProfilePhase& transformPhase = getProfilePhase("FFT", "transform");
+// Stores of lines along an axis with fftshift of centered transforms
+ProfilePhase& scatterPhase = getProfilePhase("FFT", "scatter");
+// Copies of whole tensors to f32 scratch
+ProfilePhase& copyPhase = getProfilePhase("FFT", "copy");
+
+// Complex tensor viewed as [outer, size, inner] around one of the axes
+struct AxisLayout {
+    AxisLayout(const std::vector<size_t>& dims, size_t axis)
+        : outer(std::accumulate(dims.begin(), dims.begin() + axis, size_t(1), std::multiplies<size_t>())),
+          size(dims[axis]),
+          inner(std::accumulate(dims.begin() + axis + 1, dims.end(), size_t(1), std::multiplies<size_t>())) {}
+
+    size_t outer, size, inner;
+};
+
+// Number of neighboring lines along an axis which are processed together. Their elements are
+// adjacent in memory so every gathered row of a block is a contiguous chunk.
+const size_t linesBlock = 8;
+
+// Complex number of f16 or bf16 tensors. Transforms compute in complex_t and convert values when lines
+// are gathered and scattered.
+template <typename T>
+struct ReducedComplex {
+    T re, im;
+};
+
+template <typename T>
+struct ComplexType {
+    typedef ReducedComplex<T> type;
+};
+
+template <>
+struct ComplexType<float> {
+    typedef complex_t type;
+};
+
+inline complex_t load(const complex_t& v) {
+    return v;
+}
 
-        return;
-    }
+template <typename T>
+complex_t load(const ReducedComplex<T>& v) {
+    return complex_t(toFloat(v.re), toFloat(v.im));
+}
+
+inline void store(complex_t& dst, const complex_t& v) {
+    dst = v;
+}
+
+template <typename T>
+void store(ReducedComplex<T>& dst, const complex_t& v) {
+    dst.re = fromFloat<T>(v.real());
+    dst.im = fromFloat<T>(v.imag());
+}
+
+// Copies size elements from src to dst with a cyclic shift: dst[i] = src[(i + shift) % size].
+// Both buffers are strided.
+template <typename Src, typename Dst>
+inline void copyShifted(const Src* src, size_t srcStride, Dst* dst, size_t dstStride, size_t size, size_t shift) {
+    for (size_t i = 0; i < size - shift; ++i)
+        store(dst[i * dstStride], load(src[(i + shift) * srcStride]));
+    for (size_t i = size - shift; i < size; ++i)
+        store(dst[i * dstStride], load(src[(i + shift - size) * srcStride]));
+}
+
+// Batched 1D transforms of all the lines along an axis from src to dst (which can be the same buffer).
+// Results are multiplied by scale. Centered transform applies ifftshift and fftshift along the axis by
+// remapping indices while lines are gathered and scattered, so no separate shift passes are needed:
+// shifts and transforms along different axes commute.
+template <typename Src, typename Dst>
+void transformAxis(const Src* src, Dst* dst, const std::vector<size_t>& dims, size_t axis, bool inverse,
+                   bool centered, float scale) {
+    const AxisLayout layout(dims, axis);
+    const size_t size = layout.size;
+    const size_t inner = layout.inner;
+    const auto plan = getFFTPlan(size, inverse);
+    const size_t scratchSize = plan->scratchSize();
+    // ifftshift moves element size / 2 to the beginning, fftshift moves the beginning to size / 2
+    const size_t gatherShift = centered ? size / 2 : 0;
+    const size_t scatterShift = centered ? (size + 1) / 2 : 0;
+
+    const size_t numBlocks = (inner + linesBlock - 1) / linesBlock;
+    parallelFor(opThreads, layout.outer * numBlocks, [&](size_t d) {
+        const size_t offset = (d / numBlocks) * size * inner + (d % numBlocks) * linesBlock;
+        const size_t numLines = std::min(linesBlock, inner - (d % numBlocks) * linesBlock);
+        ScratchBuffer<complex_t> scratchBuffer(scratchStats, scratchSize + numLines * size);
+        complex_t* scratch = scratchBuffer.data();
+        complex_t* lines = scratch + scratchSize;
+
+        // Innermost axis of f32 output is contiguous and is transformed in place if there is no shift
+        if (inner == 1 && !centered && std::is_same<Dst, complex_t>::value) {
+            complex_t* line = reinterpret_cast<complex_t*>(dst + offset);
+            if (static_cast<const void*>(src) != static_cast<const void*>(dst)) {
+                ProfileScope scope(gatherPhase);
+                copyShifted(src + offset, 1, line, 1, size, 0);
+            }
+            ProfileScope scope(transformPhase);
+            plan->execute(line, scratch);
+            for (size_t i = 0; i < size; ++i)
+                line[i] *= scale;
+            return;
+        }
+
+        {
+            ProfileScope scope(gatherPhase);
+            for (size_t l = 0; l < numLines; ++l)
+                copyShifted(src + offset + l, inner, lines + l * size, 1, size, gatherShift);
+        }
+        {
+            ProfileScope scope(transformPhase);
+            for (size_t l = 0; l < numLines; ++l) {
+                complex_t* line = lines + l * size;
+                plan->execute(line, scratch);
+                for (size_t i = 0; i < size; ++i)
+                    line[i] *= scale;
+            }
+        }
+        ProfileScope scope(scatterPhase);
+        for (size_t l = 0; l < numLines; ++l)
+            copyShifted(lines + l * size, 1, dst + offset + l, inner, size, scatterShift);
+    });
+}
 
-    CvMat* tl = new CvMat();
-    CvMat* tr = new CvMat();
-    CvMat* bl = new CvMat();
-    CvMat* br = new CvMat();
+// Real-to-complex transforms of all the lines along an axis. Output has the same dimensions
+// as real input except the axis which has n / 2 + 1 elements.
+template <typename Src, typename Dst>
+void realTransformAxis(const Src* inp, Dst* out, const std::vector<size_t>& realDims, size_t axis, float scale) {
+    const AxisLayout layout(realDims, axis);
+    const size_t n = layout.size;
+    const size_t m = n / 2 + 1;
+    const size_t inner = layout.inner;
+    const size_t numBlocks = (inner + linesBlock - 1) / linesBlock;
+    const auto plan = getRealFFTPlan(n, false);
+    parallelFor(opThreads, layout.outer * numBlocks, [&](size_t d) {
+        const size_t outer = d / numBlocks;
+        const size_t first = (d % numBlocks) * linesBlock;
+        const size_t numLines = std::min(linesBlock, inner - first);
+        ScratchBuffer<complex_t> scratchBuffer(scratchStats,
+                                               plan->scratchSize() + numLines * m + (numLines * n + 1) / 2);
+        complex_t* scratch = scratchBuffer.data();
+        complex_t* spectra = scratch + plan->scratchSize();
+        float* lines = reinterpret_cast<float*>(spectra + numLines * m);
+
+        const Src* src = inp + outer * n * inner + first;
+        {
+            ProfileScope scope(gatherPhase);
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t l = 0; l < numLines; ++l)
+                    lines[l * n + i] = toFloat(src[i * inner + l]);
+            }
+        }
+        {
+            ProfileScope scope(transformPhase);
+            for (size_t l = 0; l < numLines; ++l)
+                plan->forward(lines + l * n, spectra + l * m, scratch);
+        }
+        ProfileScope scope(scatterPhase);
+        Dst* dst = out + outer * m * inner + first;
+        for (size_t k = 0; k < m; ++k) {
+            for (size_t l = 0; l < numLines; ++l)
+                store(dst[k * inner + l], spectra[l * m + k] * scale);
+        }
+    });
+}
 
-    cvInitMatHeader(tl, h2, w2, CV_32FC2, data, step);
-    cvInitMatHeader(tr, h2, w2, CV_32FC2, data + width, step);
-    cvInitMatHeader(bl, h2, w2, CV_32FC2, data + height * width, step);
-    cvInitMatHeader(br, h2, w2, CV_32FC2, data + height * width + width, step);
+// Complex-to-real transforms of all the half spectra along an axis
+template <typename Src, typename Dst>
+void inverseRealTransformAxis(const Src* inp, Dst* out, const std::vector<size_t>& realDims, size_t axis,
+                              float scale) {
+    const AxisLayout layout(realDims, axis);
+    const size_t n = layout.size;
+    const size_t m = n / 2 + 1;
+    const size_t inner = layout.inner;
+    const size_t numBlocks = (inner + linesBlock - 1) / linesBlock;
+    const auto plan = getRealFFTPlan(n, true);
+    parallelFor(opThreads, layout.outer * numBlocks, [&](size_t d) {
+        const size_t outer = d / numBlocks;
+        const size_t first = (d % numBlocks) * linesBlock;
+        const size_t numLines = std::min(linesBlock, inner - first);
+        ScratchBuffer<complex_t> scratchBuffer(scratchStats,
+                                               plan->scratchSize() + numLines * m + (numLines * n + 1) / 2);
+        complex_t* scratch = scratchBuffer.data();
+        complex_t* spectra = scratch + plan->scratchSize();
+        float* lines = reinterpret_cast<float*>(spectra + numLines * m);
+
+        const Src* src = inp + outer * m * inner + first;
+        {
+            ProfileScope scope(gatherPhase);
+            for (size_t k = 0; k < m; ++k) {
+                for (size_t l = 0; l < numLines; ++l)
+                    spectra[l * m + k] = load(src[k * inner + l]);
+            }
+        }
+        {
+            ProfileScope scope(transformPhase);
+            for (size_t l = 0; l < numLines; ++l)
+                plan->backward(spectra + l * m, lines + l * n, scratch);
+        }
+        ProfileScope scope(scatterPhase);
+        Dst* dst = out + outer * n * inner + first;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t l = 0; l < numLines; ++l)
+                dst[i * inner + l] = fromFloat<Dst>(lines[l * n + i] * scale);
+        }
+    });
+}
 
-    CvArr* mask = 0;
-    CvMat* tmp = cvCloneMat(tl);
-    cvCopy(br, tl, mask);
-    cvCopy(tmp, br, mask);
+// Returns a number of elements of a single signal
+size_t getSignalSize(const std::vector<size_t>& dims, const std::vector<size_t>& axes) {
+    size_t size = 1;
+    for (size_t axis : axes)
+        size *= dims[axis];
+    return size;
+}
 
-    cvCopy(tr, tmp, mask);
-    cvCopy(bl, tr, mask);
-    cvCopy(tmp, bl, mask);
+// Transforms of a tensor of element type T. Reduced precision tensors keep intermediate results of
+// multi-dimensional transforms in f32 scratch, so values are rounded once.
+template <typename T>
+void computeFFT(const ov::Tensor& input, ov::Tensor& output, const std::vector<int64_t>& signalDims, bool inverse,
+                bool centered, bool realInput) {
+    typedef typename ComplexType<T>::type Complex;
+    const bool isFloat = std::is_same<T, float>::value;
+    std::vector<size_t> dims = input.get_shape();
+
+    if (realInput && !inverse) {
+        const std::vector<size_t> axes = getSignalAxes(signalDims, dims.size());
+        std::vector<size_t> complexDims = dims;
+        complexDims[axes.back()] = dims[axes.back()] / 2 + 1;
+        const float scale = 1.0f / sqrtf(static_cast<float>(getSignalSize(dims, axes)));
+        // Output shape is dynamic if signal dims are not constant
+        ov::Shape outShape = complexDims;
+        outShape.push_back(2);
+        output.set_shape(outShape);
+        const T* inp = input.data<T>();
+        Complex* out = reinterpret_cast<Complex*>(output.data<T>());
+
+        if (axes.size() == 1) {
+            realTransformAxis(inp, out, dims, axes.back(), scale);
+            return;
+        }
+        // f32 output is transformed in place
+        ScratchBuffer<complex_t> spectrum(scratchStats, isFloat ? 0 : output.get_size() / 2);
+        complex_t* work = isFloat ? reinterpret_cast<complex_t*>(out) : spectrum.data();
+        realTransformAxis(inp, work, dims, axes.back(), 1.0f);
+        for (size_t i = 0; i + 2 < axes.size(); ++i)
+            transformAxis(work, work, complexDims, axes[i], false, false, 1.0f);
+        transformAxis(work, out, complexDims, axes[axes.size() - 2], false, false, scale);
+        return;
+    }
 
-    cvReleaseMat(&tmp);
+    // The last dimension of size 2 keeps real and imaginary parts
+    OPENVINO_ASSERT(dims.size() >= 2 && dims.back() == 2, "FFT expects complex input with the last dimension of size 2");
+    dims.pop_back();
+    const std::vector<size_t> axes = getSignalAxes(signalDims, dims.size());
+    const Complex* inp = reinterpret_cast<const Complex*>(input.data<T>());
+
+    if (realInput) {
+        OPENVINO_ASSERT(dims[axes.back()] >= 2,
+                        "Inverse FFT of real input expects a half spectrum of at least 2 elements");
+        std::vector<size_t> realDims = dims;
+        realDims[axes.back()] = 2 * (dims[axes.back()] - 1);
+        output.set_shape(realDims);
+        const float scale = 1.0f / sqrtf(static_cast<float>(getSignalSize(realDims, axes)));
+
+        // Half spectra of the last signal dimension are restored after inverse transforms of other dimensions
+        ScratchBuffer<complex_t> spectrum(scratchStats, input.get_size() / 2);
+        {
+            ProfileScope scope(copyPhase);
+            copyShifted(inp, 1, spectrum.data(), 1, spectrum.size(), 0);
+        }
+        for (size_t i = 0; i + 1 < axes.size(); ++i)
+            transformAxis(spectrum.data(), spectrum.data(), dims, axes[i], true, false, 1.0f);
+        inverseRealTransformAxis(spectrum.data(), output.data<T>(), realDims, axes.back(), scale);
+        return;
+    }
+    const size_t signalSize = getSignalSize(dims, axes);
+    const float scale = 1.0f / sqrtf(static_cast<float>(signalSize));
+    output.set_shape(input.get_shape());
+    Complex* out = reinterpret_cast<Complex*>(output.data<T>());
+    if (axes.size() == 1) {
+        transformAxis(inp, out, dims, axes[0], inverse, centered, scale);
+        return;
+    }
 
-    delete tl;
-    delete tr;
-    delete bl;
-    delete br;
+    // The first transform reads input and the others work in place on f32 output or in f32 scratch.
+    // Orthonormalization scale is applied with the last transform.
+    ScratchBuffer<complex_t> work(scratchStats, isFloat ? 0 : input.get_size() / 2);
+    complex_t* data = isFloat ? reinterpret_cast<complex_t*>(out) : work.data();
+    transformAxis(inp, data, dims, axes[0], inverse, centered, 1.0f);
+    for (size_t i = 1; i + 1 < axes.size(); ++i)
+        transformAxis(data, data, dims, axes[i], inverse, centered, 1.0f);
+    transformAxis(data, out, dims, axes.back(), inverse, centered, scale);
 }
 
-FFT::FFT(const ov::OutputVector& args, bool inverse, bool centered) : Op(args) {
+}  // namespace
+
+FFT::FFT(const ov::OutputVector& args, bool inverse, bool centered, bool real_input)
+    : Op(args), inverse(inverse), centered(centered), real_input(real_input) {
     constructor_validate_and_infer_types();
-    this->inverse = inverse;
-    this->centered = centered;
 }
 
 void FFT::validate_and_infer_types() {
     auto outShape = get_input_partial_shape(0);
+    if (real_input) {
+        OPENVINO_ASSERT(!centered, "FFT with real input does not support centered mode");
+        // Real tensors have no trailing dimension for real and imaginary parts
+        const auto signalDims = ov::as_type_ptr<ov::op::v0::Constant>(input_value(1).get_node_shared_ptr());
+        if (outShape.rank().is_static() && signalDims) {
+            if (inverse)
+                outShape = ov::PartialShape(std::vector<ov::Dimension>(outShape.begin(), outShape.end() - 1));
+            else
+                outShape.push_back(2);
+            const size_t rank = outShape.size() - (inverse ? 0 : 1);
+            const size_t axis = getSignalAxes(signalDims->cast_vector<int64_t>(), rank).back();
+            if (outShape[axis].is_static()) {
+                const int64_t size = outShape[axis].get_length();
+                OPENVINO_ASSERT(!inverse || size >= 2,
+                                "Inverse FFT of real input expects a half spectrum of at least 2 elements");
+                outShape[axis] = inverse ? 2 * (size - 1) : size / 2 + 1;
+            }
+        } else if (outShape.rank().is_static()) {
+            outShape = ov::PartialShape::dynamic(outShape.rank().get_length() + (inverse ? -1 : 1));
+        }
+    }
     set_output_type(0, get_input_element_type(0), outShape);
 }
 
 std::shared_ptr<ov::Node> FFT::clone_with_new_inputs(const ov::OutputVector& new_args) const {
     OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
-    return std::make_shared<FFT>(new_args, inverse, centered);
+    return std::make_shared<FFT>(new_args, inverse, centered, real_input);
 }
 
 bool FFT::visit_attributes(ov::AttributeVisitor& visitor) {
     int inverse_i = static_cast<int>(inverse);
     int centered_i = static_cast<int>(centered);
+    int real_input_i = static_cast<int>(real_input);
     visitor.on_attribute("inverse", inverse_i);
     visitor.on_attribute("centered", centered_i);
+    visitor.on_attribute("real_input", real_input_i);
     inverse = static_cast<bool>(inverse_i);
     centered = static_cast<bool>(centered_i);
+    real_input = static_cast<bool>(real_input_i);
     return true;
 }
 
 bool FFT::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
-    float* inpData = reinterpret_cast<float*>(inputs[0].data());
-
     if (inputs[1].get_element_type() != ov::element::i32)
         OPENVINO_THROW("Unexpected dims type: " + inputs[1].get_element_type().to_string());
 
-    int32_t* signalDimsData = reinterpret_cast<int32_t*>(inputs[1].data());
-    float* outData = reinterpret_cast<float*>(outputs[0].data());
-    std::vector<size_t> dims = inputs[0].get_shape();
+    const int32_t* signalDimsData = reinterpret_cast<int32_t*>(inputs[1].data());
     const size_t numSignalDims = inputs[1].get_shape()[0];
-
-    if (!((dims.size() == 3 && numSignalDims == 1 && signalDimsData[0] == 1) ||
-          (dims.size() == 4 && ((numSignalDims == 1 && signalDimsData[0] == 1) ||
-                                (numSignalDims == 2 && signalDimsData[0] == 1 && signalDimsData[1] == 2))) ||
-          (dims.size() == 5 && ((numSignalDims == 2 && signalDimsData[0] == 1 && signalDimsData[1] == 2) ||
-                                (numSignalDims == 2 && signalDimsData[0] == 2 && signalDimsData[1] == 3))))) {
-        std::ostringstream ss;
-        for (size_t i = 0; i < numSignalDims; ++i)
-            ss << signalDimsData[i] << " ";
-        OPENVINO_THROW("Unsupported configuration: Input dims " + std::to_string(dims.size()) + " and signal dims " + ss.str());
-    }
-
-    const int batch = dims[0];
-
-    if (dims.size() == 5 && numSignalDims == 2 && signalDimsData[0] == 1 && signalDimsData[1] == 2) {
-        const int channels = dims[1];
-        int rows = dims[2];
-        int cols = dims[3];
-        const int planeSize = channels * rows * cols;
-        ov::parallel_for(batch * cols, [&](size_t d) {
-            int b = d / cols;
-            int col = d % cols;
-            // Copy a slice from input
-            CvMat* inpSlice = cvCreateMatHeader(channels * rows, 1, CV_32FC2);
-            CvMat* outSlice = cvCreateMatHeader(channels * rows, 1, CV_32FC2);
-            cvSetData(inpSlice, reinterpret_cast<void*>(inpData + (b * planeSize + col) * 2), cols * 2 * sizeof(float));
-            cvSetData(outSlice, reinterpret_cast<void*>(outData + (b * planeSize + col) * 2), cols * 2 * sizeof(float));
-
-            CvMat* inp_col = cvCloneMat(inpSlice);
-
-            CvMat inp_header, *inp;
-            inp = cvReshape(inp_col, &inp_header, 2, channels);
-
-            CvMat* out = cvCreateMatHeader(channels, rows, CV_32FC2);
-            cvCreateData(out);
-
-            if (centered)
-                fftshift(inp, true);
-
-            if (inverse)
-                cvDFT(inp, out, CV_DXT_INVERSE, 0);
-            else
-                cvDFT(inp, out, CV_DXT_FORWARD, 0);
-            cvScale(out, out, 1.0 / sqrtf(channels * rows), 0);
-
-            if (centered)
-                fftshift(out, false);
-
-            CvMat out_col_header, *out_col;
-            out_col = cvReshape(out, &out_col_header, 2, channels * rows);
-
-            cvCopy(out_col, outSlice, 0);
-
-            cvReleaseData(inp_col);
-            cvReleaseMat(&inp_col);
-
-            cvReleaseData(out);
-            cvReleaseMat(&out);
-
-            cvReleaseMat(&inpSlice);
-            cvReleaseMat(&outSlice);
-        });
-    } else if (dims.size() == 5 && numSignalDims == 2 && signalDimsData[0] == 2 && signalDimsData[1] == 3) {
-        const int channels = dims[1];
-        int rows = dims[2];
-        int cols = dims[3];
-        int planeSize = rows * cols * 2;  // 2 is last dimension size
-        ov::parallel_for(batch * channels, [&](size_t d) {
-            CvMat* inp = cvCreateMatHeader(rows, cols, CV_32FC2);
-            CvMat* out = cvCreateMatHeader(rows, cols, CV_32FC2);
-            cvSetData(inp, reinterpret_cast<void*>(inpData + d * planeSize), cols * 2 * sizeof(float));
-            cvSetData(out, reinterpret_cast<void*>(outData + d * planeSize), cols * 2 * sizeof(float));
-
-            if (centered)
-                fftshift(inp, true);
-
-            if (inverse)
-                cvDFT(inp, out, CV_DXT_INVERSE, 0);
-            else
-                cvDFT(inp, out, CV_DXT_FORWARD, 0);
-            cvScale(out, out, 1.0 / sqrtf(cols * rows), 0);
-
-            if (centered)
-                fftshift(out, false);
-
-            cvReleaseMat(&inp);
-            cvReleaseMat(&out);
-        });
-    } else if (dims.size() == 4 && numSignalDims == 2 && signalDimsData[0] == 1 && signalDimsData[1] == 2) {
-        int rows = dims[1];
-        int cols = dims[2];
-        int planeSize = rows * cols * 2;  // 2 is last dimension size
-        ov::parallel_for(batch, [&](size_t d) {
-            CvMat* inp = cvCreateMatHeader(rows, cols, CV_32FC2);
-            CvMat* out = cvCreateMatHeader(rows, cols, CV_32FC2);
-            cvSetData(inp, reinterpret_cast<void*>(inpData + d * planeSize), cols * 2 * sizeof(float));
-            cvSetData(out, reinterpret_cast<void*>(outData + d * planeSize), cols * 2 * sizeof(float));
-
-            if (centered)
-                fftshift(inp, true);
-
-            if (inverse)
-                cvDFT(inp, out, CV_DXT_INVERSE, 0);
-            else
-                cvDFT(inp, out, CV_DXT_FORWARD, 0);
-            cvScale(out, out, 1.0 / sqrtf(cols * rows), 0);
-
-            if (centered)
-                fftshift(out, false);
-
-            cvReleaseMat(&inp);
-            cvReleaseMat(&out);
-        });
-    } else if (dims.size() == 4 && numSignalDims == 1 && signalDimsData[0] == 1) {
-        int rows = dims[1];
-        int cols = dims[2];
-
-        const int planeSize = rows;
-        ov::parallel_for(batch * cols, [&](size_t d) {
-            int b = d / cols;
-            int col = d % cols;
-            CvMat* inp = cvCreateMatHeader(rows, 1, CV_32FC2);
-            CvMat* out = cvCreateMatHeader(rows, 1, CV_32FC2);
-            cvSetData(inp, reinterpret_cast<void*>(inpData + (b * planeSize * cols + col) * 2), cols * 2 * sizeof(float));
-            cvSetData(out, reinterpret_cast<void*>(outData + (b * planeSize * cols + col) * 2), cols * 2 * sizeof(float));
-
-            if (centered)
-                fftshift(inp, true);
-
-            if (inverse)
-                cvDFT(inp, out, CV_DXT_INVERSE, 0);
-            else
-                cvDFT(inp, out, CV_DXT_FORWARD, 0);
-            cvScale(out, out, 1.0 / sqrtf(rows), 0);
-
-            if (centered)
-                fftshift(out, false);
-
-            cvReleaseMat(&inp);
-            cvReleaseMat(&out);
-        });
-    } else if (dims.size() == 3) {
-        int rows = dims[0];
-        int cols = dims[1];
-        CvMat* inp = cvCreateMatHeader(rows, cols, CV_32FC2);
-        CvMat* out = cvCreateMatHeader(rows, cols, CV_32FC2);
-        cvSetData(inp, reinterpret_cast<void*>(inpData), cols * 2 * sizeof(float));
-        cvSetData(out, reinterpret_cast<void*>(outData), cols * 2 * sizeof(float));
-
-        if (inverse)
-            cvDFT(inp, out, CV_DXT_INVERSE | CV_DXT_ROWS, 0);
-        else
-            cvDFT(inp, out, CV_DXT_FORWARD | CV_DXT_ROWS, 0);
-        cvScale(out, out, 1.0 / sqrtf(cols), 0);
-
-        cvReleaseMat(&inp);
-        cvReleaseMat(&out);
+    const std::vector<int64_t> signalDims(signalDimsData, signalDimsData + numSignalDims);
+
+    ProfileScope scope(totalPhase);
+    switch (inputs[0].get_element_type()) {
+    case ov::element::f32:
+        computeFFT<float>(inputs[0], outputs[0], signalDims, inverse, centered, real_input);
+        break;
+    case ov::element::f16:
+        computeFFT<ov::float16>(inputs[0], outputs[0], signalDims, inverse, centered, real_input);
+        break;
+    case ov::element::bf16:
+        computeFFT<ov::bfloat16>(inputs[0], outputs[0], signalDims, inverse, centered, real_input);
+        break;
+    default:
+        OPENVINO_THROW("Unexpected input type: " + inputs[0].get_element_type().to_string());
     }
     return true;
 }
 
 bool FFT::has_evaluate() const {
-    if (get_input_element_type(0) == ov::element::f32 && get_input_element_type(1) == ov::element::i32)
+    if (isEvaluatedFloatType(get_input_element_type(0)) && get_input_element_type(1) == ov::element::i32)
         return true;
     return false;
 }
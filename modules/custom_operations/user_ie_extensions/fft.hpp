@@ -13,7 +13,7 @@ public:
     OPENVINO_OP("FFT");
 
     FFT() = default;
-    FFT(const ov::OutputVector& args, bool inverse, bool centered);
+    FFT(const ov::OutputVector& args, bool inverse, bool centered, bool real_input = false);
     void validate_and_infer_types() override;
     std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
     bool visit_attributes(ov::AttributeVisitor& visitor) override;
@@ -21,9 +21,22 @@ public:
     bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
     bool has_evaluate() const override;
 
+    bool get_inverse() const {
+        return inverse;
+    }
+    bool get_centered() const {
+        return centered;
+    }
+    bool get_real_input() const {
+        return real_input;
+    }
+
 private:
     bool inverse = false;
     bool centered = false;
+    // Forward transform of a real signal produces a half spectrum of n / 2 + 1 elements along the last
+    // signal dimension. Inverse transform takes a half spectrum and produces a real signal of n = 2 * (m - 1).
+    bool real_input = false;
 };
 
 }  // namespace TemplateExtension
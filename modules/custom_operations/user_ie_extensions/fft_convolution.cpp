@@ -0,0 +1,304 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "fft_convolution.hpp"
+
+#include <functional>
+#include <numeric>
+
+#include <openvino/core/graph_util.hpp>
+#include <openvino/core/parallel.hpp>
+#include <openvino/core/rt_info.hpp>
+#include <openvino/op/constant.hpp>
+#include <openvino/pass/pattern/op/wrap_type.hpp>
+
+#include "complex_mul.hpp"
+#include "fft.hpp"
+#include "fft_engine.hpp"
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "scratch_arena.hpp"
+
+using namespace TemplateExtension;
+
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("FFTConvolution");
+OpThreads& opThreads = getOpThreads("FFTConvolution");
+ProfilePhase& totalPhase = getProfilePhase("FFTConvolution", "total");
+// Copies of signals to contiguous blocks and back, with shifts of centered transforms
+ProfilePhase& gatherPhase = getProfilePhase("FFTConvolution", "gather");
+ProfilePhase& scatterPhase = getProfilePhase("FFTConvolution", "scatter");
+// Forward and inverse transforms of blocks
+ProfilePhase& transformPhase = getProfilePhase("FFTConvolution", "transform");
+ProfilePhase& multiplyPhase = getProfilePhase("FFTConvolution", "multiply");
+
+// Number of neighboring lines along an axis which are processed together
+const size_t linesBlock = 8;
+
+// Checks that a filter spectrum can be multiplied by a signal spectrum without changing its shape
+bool isBroadcastable(const ov::Shape& filterShape, const ov::Shape& signalShape) {
+    if (filterShape.size() > signalShape.size() || filterShape.empty() || filterShape.back() != 2)
+        return false;
+    const size_t offset = signalShape.size() - filterShape.size();
+    for (size_t i = 0; i < filterShape.size(); ++i) {
+        if (filterShape[i] != 1 && filterShape[i] != signalShape[offset + i])
+            return false;
+    }
+    return true;
+}
+
+// Calls func(i, offset) for every element of a block in row-major order. Offset of an element is
+// a sum of offsets of its coordinates along every axis of the block.
+template <typename F>
+void forEachElement(const std::vector<std::vector<size_t>>& offsets, F func) {
+    const size_t numAxes = offsets.size();
+    const std::vector<size_t>& innerOffsets = offsets.back();
+    ScratchBuffer<size_t> idx(scratchStats, numAxes);
+    std::fill(idx.data(), idx.data() + numAxes, 0);
+    for (size_t i = 0;;) {
+        size_t base = 0;
+        for (size_t j = 0; j + 1 < numAxes; ++j)
+            base += offsets[j][idx[j]];
+        for (size_t k = 0; k < innerOffsets.size(); ++k)
+            func(i++, base + innerOffsets[k]);
+
+        size_t j = numAxes - 1;
+        for (; j > 0; --j) {
+            if (++idx[j - 1] < offsets[j - 1].size())
+                break;
+            idx[j - 1] = 0;
+        }
+        if (j == 0)
+            return;
+    }
+}
+
+// N-dimensional transform of a contiguous block. Scratch keeps linesBlock lines followed by a plan scratch.
+void transformBlock(complex_t* data,
+                    const std::vector<size_t>& dims,
+                    const std::vector<std::shared_ptr<const FFTPlan>>& plans,
+                    complex_t* scratch) {
+    size_t inner = std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<size_t>());
+    const size_t volume = inner;
+    for (size_t j = 0; j < dims.size(); ++j) {
+        const size_t size = dims[j];
+        inner /= size;
+        const size_t outer = volume / (size * inner);
+        complex_t* lines = scratch;
+        complex_t* planScratch = scratch + linesBlock * size;
+        for (size_t o = 0; o < outer; ++o) {
+            for (size_t first = 0; first < inner; first += linesBlock) {
+                complex_t* src = data + o * size * inner + first;
+                if (inner == 1) {
+                    plans[j]->execute(src, planScratch);
+                    continue;
+                }
+                const size_t numLines = std::min(linesBlock, inner - first);
+                for (size_t i = 0; i < size; ++i) {
+                    for (size_t l = 0; l < numLines; ++l)
+                        lines[l * size + i] = src[i * inner + l];
+                }
+                for (size_t l = 0; l < numLines; ++l)
+                    plans[j]->execute(lines + l * size, planScratch);
+                for (size_t i = 0; i < size; ++i) {
+                    for (size_t l = 0; l < numLines; ++l)
+                        src[i * inner + l] = lines[l * size + i];
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+FFTConvolution::FFTConvolution(const ov::OutputVector& args, bool centered) : Op(args), centered(centered) {
+    constructor_validate_and_infer_types();
+}
+
+void FFTConvolution::validate_and_infer_types() {
+    auto outShape = get_input_partial_shape(0);
+    set_output_type(0, get_input_element_type(0), outShape);
+}
+
+std::shared_ptr<ov::Node> FFTConvolution::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<FFTConvolution>(new_args, centered);
+}
+
+bool FFTConvolution::visit_attributes(ov::AttributeVisitor& visitor) {
+    int centered_i = static_cast<int>(centered);
+    visitor.on_attribute("centered", centered_i);
+    centered = static_cast<bool>(centered_i);
+    return true;
+}
+
+bool FFTConvolution::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    ProfileScope scope(totalPhase);
+    const complex_t* inp = reinterpret_cast<const complex_t*>(inputs[0].data());
+    const complex_t* filter = reinterpret_cast<const complex_t*>(inputs[1].data());
+    complex_t* out = reinterpret_cast<complex_t*>(outputs[0].data());
+
+    if (inputs[2].get_element_type() != ov::element::i32)
+        OPENVINO_THROW("Unexpected dims type: " + inputs[2].get_element_type().to_string());
+
+    const ov::Shape& filterShape = inputs[1].get_shape();
+    OPENVINO_ASSERT(isBroadcastable(filterShape, inputs[0].get_shape()),
+                    "FFTConvolution filter spectrum is not broadcastable to the signal shape");
+
+    const int32_t* signalDimsData = reinterpret_cast<int32_t*>(inputs[2].data());
+    const std::vector<int64_t> signalDims(signalDimsData, signalDimsData + inputs[2].get_shape()[0]);
+
+    // Complex dimensions without a trailing one for real and imaginary parts
+    std::vector<size_t> dims = inputs[0].get_shape();
+    dims.pop_back();
+    const size_t rank = dims.size();
+    std::vector<size_t> axes = getSignalAxes(signalDims, rank);
+    std::sort(axes.begin(), axes.end());
+
+    // Strides of signal and filter. Broadcasted filter dimensions have zero strides.
+    std::vector<size_t> strides(rank), filterStrides(rank);
+    size_t stride = 1, filterStride = 1;
+    for (size_t i = rank; i-- > 0;) {
+        const size_t filterDim = i + filterShape.size() > rank ? filterShape[i + filterShape.size() - 1 - rank] : 1;
+        strides[i] = stride;
+        filterStrides[i] = filterDim == 1 ? 0 : filterStride;
+        stride *= dims[i];
+        filterStride *= filterDim;
+    }
+
+    // Every signal is gathered into a contiguous block and transformed there. Centered transforms
+    // shift signals while they are gathered and scattered. Filter is shifted in the same way so
+    // the block spectrum is never shifted either.
+    std::vector<size_t> blockDims;
+    std::vector<std::vector<size_t>> offsets(axes.size()), filterOffsets(axes.size());
+    std::vector<std::shared_ptr<const FFTPlan>> forwardPlans, inversePlans;
+    size_t scratchSize = 0;
+    for (size_t j = 0; j < axes.size(); ++j) {
+        const size_t size = dims[axes[j]];
+        for (size_t k = 0; k < size; ++k) {
+            const size_t idx = centered ? (k + size / 2) % size : k;
+            offsets[j].push_back(idx * strides[axes[j]]);
+            filterOffsets[j].push_back(idx * filterStrides[axes[j]]);
+        }
+        blockDims.push_back(size);
+        forwardPlans.push_back(getFFTPlan(size, false));
+        inversePlans.push_back(getFFTPlan(size, true));
+        scratchSize = std::max(scratchSize, linesBlock * size + std::max(forwardPlans.back()->scratchSize(),
+                                                                         inversePlans.back()->scratchSize()));
+    }
+    const size_t blockSize = std::accumulate(blockDims.begin(), blockDims.end(), size_t(1), std::multiplies<size_t>());
+    // Orthonormalization scales of both transforms are applied together with the filter
+    const float scale = 1.0f / static_cast<float>(blockSize);
+
+    std::vector<size_t> batchAxes;
+    for (size_t i = 0; i < rank; ++i) {
+        if (std::find(axes.begin(), axes.end(), i) == axes.end())
+            batchAxes.push_back(i);
+    }
+    const size_t numBlocks = inputs[0].get_size() / 2 / blockSize;
+
+    parallelFor(opThreads, numBlocks, [&](size_t b) {
+        size_t base = 0, filterBase = 0;
+        for (size_t i = batchAxes.size(); i-- > 0;) {
+            const size_t axis = batchAxes[i];
+            base += (b % dims[axis]) * strides[axis];
+            filterBase += (b % dims[axis]) * filterStrides[axis];
+            b /= dims[axis];
+        }
+
+        ScratchBuffer<complex_t> blockBuffer(scratchStats, blockSize + scratchSize);
+        complex_t* block = blockBuffer.data();
+        complex_t* scratch = block + blockSize;
+
+        {
+            ProfileScope scope(gatherPhase);
+            forEachElement(offsets, [&](size_t i, size_t offset) {
+                block[i] = inp[base + offset];
+            });
+        }
+        {
+            ProfileScope scope(transformPhase);
+            transformBlock(block, blockDims, forwardPlans, scratch);
+        }
+        {
+            ProfileScope scope(multiplyPhase);
+            forEachElement(filterOffsets, [&](size_t i, size_t offset) {
+                block[i] = cmul(block[i], filter[filterBase + offset]) * scale;
+            });
+        }
+        {
+            ProfileScope scope(transformPhase);
+            transformBlock(block, blockDims, inversePlans, scratch);
+        }
+        ProfileScope scope(scatterPhase);
+        forEachElement(offsets, [&](size_t i, size_t offset) {
+            out[base + offset] = block[i];
+        });
+    });
+    return true;
+}
+
+bool FFTConvolution::has_evaluate() const {
+    return get_input_element_type(0) == ov::element::f32 && get_input_element_type(1) == ov::element::f32 &&
+           get_input_element_type(2) == ov::element::i32;
+}
+
+FFTConvolutionFusion::FFTConvolutionFusion() {
+    using namespace ov::pass::pattern;
+
+    auto signal = any_input();
+    auto filter = any_input();
+    auto forward = wrap_type<FFT>({signal, wrap_type<ov::op::v0::Constant>()}, consumers_count(1));
+    auto mul = wrap_type<ComplexMultiplication>({forward, filter}, consumers_count(1));
+    auto backward = wrap_type<FFT>({mul, wrap_type<ov::op::v0::Constant>()});
+
+    ov::matcher_pass_callback callback = [=](Matcher& m) {
+        const auto& values = m.get_pattern_value_map();
+        const auto forwardNode = ov::as_type_ptr<FFT>(values.at(forward).get_node_shared_ptr());
+        const auto mulNode = values.at(mul).get_node_shared_ptr();
+        const auto backwardNode = ov::as_type_ptr<FFT>(values.at(backward).get_node_shared_ptr());
+        if (forwardNode->get_inverse() || !backwardNode->get_inverse() || forwardNode->get_real_input() ||
+            backwardNode->get_real_input() || forwardNode->get_centered() != backwardNode->get_centered())
+            return false;
+
+        const auto& signalShape = values.at(signal).get_partial_shape();
+        const auto& filterShape = values.at(filter).get_partial_shape();
+        if (signalShape.is_dynamic() || filterShape.is_dynamic() ||
+            !isBroadcastable(filterShape.to_shape(), signalShape.to_shape()))
+            return false;
+        if (values.at(signal).get_element_type() != ov::element::f32 ||
+            values.at(filter).get_element_type() != ov::element::f32)
+            return false;
+
+        // Both transforms must be applied along the same axes
+        const size_t rank = signalShape.size() - 1;
+        std::vector<size_t> forwardAxes, backwardAxes;
+        try {
+            forwardAxes = getSignalAxes(
+                ov::as_type_ptr<ov::op::v0::Constant>(forwardNode->get_input_node_shared_ptr(1))->cast_vector<int64_t>(),
+                rank);
+            backwardAxes = getSignalAxes(
+                ov::as_type_ptr<ov::op::v0::Constant>(backwardNode->get_input_node_shared_ptr(1))->cast_vector<int64_t>(),
+                rank);
+        } catch (const std::exception&) {
+            return false;
+        }
+        std::sort(forwardAxes.begin(), forwardAxes.end());
+        std::sort(backwardAxes.begin(), backwardAxes.end());
+        if (forwardAxes != backwardAxes)
+            return false;
+
+        auto fused = std::make_shared<FFTConvolution>(
+            ov::OutputVector{values.at(signal), values.at(filter), forwardNode->input_value(1)},
+            forwardNode->get_centered());
+        fused->set_friendly_name(backwardNode->get_friendly_name());
+        ov::copy_runtime_info({forwardNode, mulNode, backwardNode}, fused);
+        ov::replace_node(backwardNode, fused);
+        return true;
+    };
+
+    auto m = std::make_shared<Matcher>(backward, "FFTConvolutionFusion");
+    register_matcher(m, callback);
+}
@@ -0,0 +1,39 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+#include <openvino/pass/graph_rewrite.hpp>
+
+namespace TemplateExtension {
+
+// Circular convolution computed in frequency domain: IFFT(FFT(x) * H) with the same signal
+// dimensions and centering for both transforms. Inputs are a complex signal, a complex filter
+// spectrum which is broadcastable to the signal shape and signal dimensions.
+class FFTConvolution : public ov::op::Op {
+public:
+    OPENVINO_OP("FFTConvolution");
+
+    FFTConvolution() = default;
+    FFTConvolution(const ov::OutputVector& args, bool centered);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+
+private:
+    bool centered = false;
+};
+
+// Replaces FFT -> ComplexMultiplication -> inverse FFT chains by FFTConvolution
+class FFTConvolutionFusion : public ov::pass::MatcherPass {
+public:
+    OPENVINO_RTTI("FFTConvolutionFusion", "0");
+    FFTConvolutionFusion();
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,379 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <openvino/core/except.hpp>
+
+namespace TemplateExtension {
+
+typedef std::complex<float> complex_t;
+
+const double fftPi = 3.14159265358979323846;
+
+// std::complex multiplication handles infinities and NaNs by a slow library call
+inline complex_t cmul(const complex_t& a, const complex_t& b) {
+    return complex_t(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// Precomputed unnormalized 1D discrete Fourier transform of a fixed length and direction.
+// Lengths are decomposed into radix 4, 2, 3 and other small prime factors and the transform is done
+// by Stockham autosort algorithm which does not need a bit-reversal permutation.
+// Lengths with large prime factors use Bluestein's algorithm on top of a power of two transform.
+class FFTPlan {
+public:
+    FFTPlan(size_t n, bool inverse) : n(n), inverse(inverse) {
+        OPENVINO_ASSERT(n > 0, "FFT is not defined for signals of zero length");
+        std::vector<size_t> radices = factorize(n);
+        if (!radices.empty() && radices.back() > maxRadix) {
+            initBluestein();
+            return;
+        }
+
+        size_t stride = 1;
+        for (size_t radix : radices) {
+            Stage stage;
+            stage.radix = radix;
+            stage.stride = stride;
+            // Twiddle factors w^(r * k) where w is a root of unity of order radix * stride
+            stage.twiddles.resize(stride * (radix - 1));
+            for (size_t k = 0; k < stride; ++k) {
+                for (size_t r = 1; r < radix; ++r)
+                    stage.twiddles[k * (radix - 1) + r - 1] = root(r * k, radix * stride);
+            }
+            // Roots of unity of order radix for a generic butterfly
+            if (radix > 4) {
+                stage.roots.resize(radix);
+                for (size_t r = 0; r < radix; ++r)
+                    stage.roots[r] = root(r, radix);
+            }
+            stages.push_back(stage);
+            stride *= radix;
+        }
+    }
+
+    size_t size() const {
+        return n;
+    }
+
+    // Number of complex elements required for a scratch buffer
+    size_t scratchSize() const {
+        return bluesteinPlan ? 2 * bluesteinPlan->size() + bluesteinPlan->scratchSize() : n;
+    }
+
+    // Transforms n elements of data in place. scratch must have at least scratchSize() elements.
+    void execute(complex_t* data, complex_t* scratch) const {
+        if (bluesteinPlan) {
+            executeBluestein(data, scratch);
+            return;
+        }
+
+        complex_t* src = data;
+        complex_t* dst = scratch;
+        for (const auto& stage : stages) {
+            executeStage(stage, src, dst);
+            std::swap(src, dst);
+        }
+        if (src != data)
+            std::copy(src, src + n, data);
+    }
+
+private:
+    struct Stage {
+        size_t radix;
+        size_t stride;
+        std::vector<complex_t> twiddles;
+        std::vector<complex_t> roots;
+    };
+
+    // Prime factors above this limit are computed by Bluestein's algorithm
+    static const size_t maxRadix = 64;
+
+    static std::vector<size_t> factorize(size_t n) {
+        std::vector<size_t> radices;
+        while (n % 4 == 0) {
+            radices.push_back(4);
+            n /= 4;
+        }
+        for (size_t p = 2; p * p <= n; ++p) {
+            while (n % p == 0) {
+                radices.push_back(p);
+                n /= p;
+            }
+        }
+        if (n > 1)
+            radices.push_back(n);
+        return radices;
+    }
+
+    // exp(+-2 * pi * i * k / order) computed in double precision
+    complex_t root(size_t k, size_t order) const {
+        const double angle = (inverse ? 2.0 : -2.0) * fftPi * static_cast<double>(k % order) / order;
+        return complex_t(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    // One step of Stockham algorithm: radix-point butterflies of elements which are n / radix apart
+    void executeStage(const Stage& stage, const complex_t* src, complex_t* dst) const {
+        const size_t radix = stage.radix;
+        const size_t stride = stage.stride;
+        const size_t span = n / radix;
+        const size_t numBlocks = span / stride;
+        complex_t v[maxRadix];
+
+        for (size_t b = 0; b < numBlocks; ++b) {
+            for (size_t k = 0; k < stride; ++k) {
+                const size_t j = b * stride + k;
+                const complex_t* tw = stage.twiddles.data() + k * (radix - 1);
+                v[0] = src[j];
+                for (size_t r = 1; r < radix; ++r)
+                    v[r] = cmul(src[j + r * span], tw[r - 1]);
+
+                complex_t* out = dst + b * stride * radix + k;
+                butterfly(stage, v, out, stride);
+            }
+        }
+    }
+
+    void butterfly(const Stage& stage, complex_t* v, complex_t* out, size_t stride) const {
+        switch (stage.radix) {
+        case 2:
+            out[0] = v[0] + v[1];
+            out[stride] = v[0] - v[1];
+            break;
+        case 3: {
+            // sin(2 * pi / 3) with a sign of the transform direction
+            const float s = inverse ? 0.86602540378f : -0.86602540378f;
+            const complex_t sum = v[1] + v[2];
+            const complex_t diff = v[1] - v[2];
+            const complex_t t = v[0] - 0.5f * sum;
+            const complex_t u(-s * diff.imag(), s * diff.real());
+            out[0] = v[0] + sum;
+            out[stride] = t + u;
+            out[2 * stride] = t - u;
+            break;
+        }
+        case 4: {
+            const complex_t t0 = v[0] + v[2];
+            const complex_t t1 = v[0] - v[2];
+            const complex_t t2 = v[1] + v[3];
+            const complex_t d = v[1] - v[3];
+            // Multiplication by -i for forward transform and by i for inverse one
+            const complex_t t3 = inverse ? complex_t(-d.imag(), d.real()) : complex_t(d.imag(), -d.real());
+            out[0] = t0 + t2;
+            out[stride] = t1 + t3;
+            out[2 * stride] = t0 - t2;
+            out[3 * stride] = t1 - t3;
+            break;
+        }
+        default: {
+            const size_t radix = stage.radix;
+            for (size_t q = 0; q < radix; ++q) {
+                complex_t sum = v[0];
+                size_t idx = 0;
+                for (size_t r = 1; r < radix; ++r) {
+                    idx += q;
+                    if (idx >= radix)
+                        idx -= radix;
+                    sum += cmul(v[r], stage.roots[idx]);
+                }
+                out[q * stride] = sum;
+            }
+        }
+        }
+    }
+
+    void initBluestein() {
+        size_t m = 1;
+        while (m < 2 * n - 1)
+            m *= 2;
+        bluesteinPlan = std::make_shared<FFTPlan>(m, false);
+        bluesteinInversePlan = std::make_shared<FFTPlan>(m, true);
+
+        // Chirp w_j = exp(-+pi * i * j^2 / n). j^2 is reduced modulo 2n to keep precision.
+        chirp.resize(n);
+        for (size_t j = 0; j < n; ++j) {
+            const size_t j2 = static_cast<size_t>((static_cast<unsigned long long>(j) * j) % (2 * n));
+            const double angle = (inverse ? 1.0 : -1.0) * fftPi * static_cast<double>(j2) / n;
+            chirp[j] = complex_t(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+
+        // Spectrum of a convolution kernel conj(w) scaled by 1/m to compensate unnormalized inverse transform
+        chirpSpectrum.assign(m, complex_t(0, 0));
+        chirpSpectrum[0] = std::conj(chirp[0]);
+        for (size_t j = 1; j < n; ++j)
+            chirpSpectrum[j] = chirpSpectrum[m - j] = std::conj(chirp[j]);
+        std::vector<complex_t> scratch(bluesteinPlan->scratchSize());
+        bluesteinPlan->execute(chirpSpectrum.data(), scratch.data());
+        for (auto& val : chirpSpectrum)
+            val *= 1.0f / m;
+    }
+
+    void executeBluestein(complex_t* data, complex_t* scratch) const {
+        const size_t m = bluesteinPlan->size();
+        complex_t* conv = scratch;
+        complex_t* planScratch = scratch + m;
+        for (size_t j = 0; j < n; ++j)
+            conv[j] = cmul(data[j], chirp[j]);
+        std::fill(conv + n, conv + m, complex_t(0, 0));
+
+        bluesteinPlan->execute(conv, planScratch);
+        for (size_t j = 0; j < m; ++j)
+            conv[j] = cmul(conv[j], chirpSpectrum[j]);
+        bluesteinInversePlan->execute(conv, planScratch);
+
+        for (size_t k = 0; k < n; ++k)
+            data[k] = cmul(conv[k], chirp[k]);
+    }
+
+    size_t n;
+    bool inverse;
+    std::vector<Stage> stages;
+
+    std::shared_ptr<FFTPlan> bluesteinPlan;
+    std::shared_ptr<FFTPlan> bluesteinInversePlan;
+    std::vector<complex_t> chirp;
+    std::vector<complex_t> chirpSpectrum;
+};
+
+// Transform of a real signal of length n to a half spectrum of n / 2 + 1 elements (Hermitian symmetry
+// defines the rest) and the inverse transform of a half spectrum to a real signal.
+// For even n a real signal is packed to a complex one of length n / 2 which halves the work.
+class RealFFTPlan {
+public:
+    RealFFTPlan(size_t n, bool inverse) : n(n), inverse(inverse) {
+        OPENVINO_ASSERT(n % 2 == 0 || !inverse, "Inverse real transform supports only even lengths");
+        if (n % 2) {
+            plan = std::make_shared<FFTPlan>(n, inverse);
+            return;
+        }
+        plan = std::make_shared<FFTPlan>(n / 2, inverse);
+        twiddles.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            const double angle = (inverse ? 2.0 : -2.0) * fftPi * static_cast<double>(k) / n;
+            twiddles[k] = complex_t(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+    }
+
+    size_t size() const {
+        return n;
+    }
+
+    // Number of complex elements required for a scratch buffer
+    size_t scratchSize() const {
+        return plan->size() + plan->scratchSize();
+    }
+
+    // Computes n / 2 + 1 elements of a spectrum of a real signal
+    void forward(const float* inp, complex_t* out, complex_t* scratch) const {
+        complex_t* z = scratch;
+        complex_t* planScratch = scratch + plan->size();
+        if (n % 2) {
+            for (size_t i = 0; i < n; ++i)
+                z[i] = complex_t(inp[i], 0.0f);
+            plan->execute(z, planScratch);
+            std::copy(z, z + n / 2 + 1, out);
+            return;
+        }
+
+        // Even and odd samples are real and imaginary parts of a half length signal
+        const size_t half = n / 2;
+        for (size_t i = 0; i < half; ++i)
+            z[i] = complex_t(inp[2 * i], inp[2 * i + 1]);
+        plan->execute(z, planScratch);
+
+        // X[k] = E[k] + w^k * O[k] where E and O are spectra of even and odd samples
+        for (size_t k = 0; k <= half; ++k) {
+            const complex_t a = z[k % half];
+            const complex_t b = std::conj(z[(half - k) % half]);
+            const complex_t even = 0.5f * (a + b);
+            const complex_t diff = 0.5f * (a - b);
+            const complex_t odd(diff.imag(), -diff.real());
+            out[k] = even + cmul(k < half ? twiddles[k] : complex_t(-1.0f, 0.0f), odd);
+        }
+    }
+
+    // Computes n real samples from n / 2 + 1 elements of a half spectrum
+    void backward(const complex_t* inp, float* out, complex_t* scratch) const {
+        complex_t* z = scratch;
+        complex_t* planScratch = scratch + plan->size();
+        const size_t half = n / 2;
+
+        // Spectra of even and odd samples are combined to a spectrum of a half length complex signal.
+        // Imaginary parts of zero and Nyquist frequencies are ignored as they are zero for any real signal.
+        for (size_t k = 0; k < half; ++k) {
+            const complex_t a = k == 0 ? complex_t(inp[0].real(), 0.0f) : inp[k];
+            const complex_t b = k == 0 ? complex_t(inp[half].real(), 0.0f) : std::conj(inp[half - k]);
+            const complex_t even = a + b;
+            const complex_t odd = cmul(a - b, twiddles[k]);
+            z[k] = even + complex_t(-odd.imag(), odd.real());
+        }
+        plan->execute(z, planScratch);
+        for (size_t i = 0; i < half; ++i) {
+            out[2 * i] = z[i].real();
+            out[2 * i + 1] = z[i].imag();
+        }
+    }
+
+private:
+    size_t n;
+    bool inverse;
+    std::shared_ptr<FFTPlan> plan;
+    std::vector<complex_t> twiddles;
+};
+
+// Returns a plan for a given length and direction. Plans are created once and shared
+// between all the threads and evaluate calls.
+template <typename Plan>
+std::shared_ptr<const Plan> getCachedPlan(size_t n, bool inverse) {
+    static std::mutex mutex;
+    static std::map<std::pair<size_t, bool>, std::shared_ptr<const Plan>> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& plan = plans[std::make_pair(n, inverse)];
+    if (!plan)
+        plan = std::make_shared<Plan>(n, inverse);
+    return plan;
+}
+
+inline std::shared_ptr<const FFTPlan> getFFTPlan(size_t n, bool inverse) {
+    return getCachedPlan<FFTPlan>(n, inverse);
+}
+
+inline std::shared_ptr<const RealFFTPlan> getRealFFTPlan(size_t n, bool inverse) {
+    return getCachedPlan<RealFFTPlan>(n, inverse);
+}
+
+// Normalizes signal dimensions to axes of a tensor of a given rank
+inline std::vector<size_t> getSignalAxes(const std::vector<int64_t>& signalDims, size_t rank) {
+    std::vector<size_t> axes;
+    for (int64_t axis : signalDims) {
+        if (axis < 0)
+            axis += static_cast<int64_t>(rank);
+        if (axis < 0 || axis >= static_cast<int64_t>(rank) ||
+            std::find(axes.begin(), axes.end(), static_cast<size_t>(axis)) != axes.end())
+            break;
+        axes.push_back(static_cast<size_t>(axis));
+    }
+    // At least one signal dimension is required
+    if (axes.empty() || axes.size() != signalDims.size()) {
+        std::ostringstream ss;
+        for (int64_t dim : signalDims)
+            ss << dim << " ";
+        OPENVINO_THROW("Unsupported configuration: Input dims " + std::to_string(rank) + " and signal dims " + ss.str());
+    }
+    return axes;
+}
+
+}  // namespace TemplateExtension
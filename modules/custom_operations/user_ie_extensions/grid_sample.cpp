@@ -3,111 +3,690 @@
 //
 
 #include "grid_sample.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
 #include <openvino/core/parallel.hpp>
+#include <openvino/op/constant.hpp>
+
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "reduced_precision.hpp"
+#include "scratch_arena.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define GRID_SAMPLE_X86
+#    include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#    define GRID_SAMPLE_NEON
+#    include <arm_neon.h>
+#endif
 
 using namespace TemplateExtension;
 
-GridSample::GridSample(const ov::OutputVector& args) : Op(args) {
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("GridSample");
+OpThreads& opThreads = getOpThreads("GridSample");
+ProfilePhase& totalPhase = getProfilePhase("GridSample", "total");
+// Transposition of input rows to NHWC layout, which is done by the tasks of output rows
+ProfilePhase& transposePhase = getProfilePhase("GridSample", "transpose");
+// Taps and weights of grid points, including plans of constant grids
+ProfilePhase& tapsPhase = getProfilePhase("GridSample", "taps");
+ProfilePhase& samplePhase = getProfilePhase("GridSample", "sample");
+
+// Minimal number of channels to sample an input transposed to NHWC layout, where every tap
+// is a contiguous vector of channels
+const size_t nhwcMinChannels = 16;
+// Coordinates are clamped to keep them representable by integers. Far away points stay outside of the input.
+const float maxCoordinate = static_cast<float>(1 << 22);
+
+enum class Interpolation { Nearest, Bilinear, Bicubic };
+enum class Padding { Zeros, Border, Reflection };
+
+struct SamplingParams {
+    Interpolation interpolation;
+    Padding padding;
+    bool alignCorners;
+    size_t inpHeight, inpWidth;
+
+    // Every output pixel is a weighted sum of numTaps input pixels
+    size_t numTaps() const {
+        return interpolation == Interpolation::Nearest ? 1 : interpolation == Interpolation::Bilinear ? 4 : 16;
+    }
+};
+
+Interpolation getInterpolation(const std::string& mode) {
+    // ONNX GridSample since opset 20 names modes linear and cubic
+    if (mode == "nearest")
+        return Interpolation::Nearest;
+    if (mode == "bilinear" || mode == "linear")
+        return Interpolation::Bilinear;
+    if (mode == "bicubic" || mode == "cubic")
+        return Interpolation::Bicubic;
+    OPENVINO_THROW("Unsupported GridSample mode: " + mode);
+}
+
+Padding getPadding(const std::string& paddingMode) {
+    if (paddingMode == "zeros")
+        return Padding::Zeros;
+    if (paddingMode == "border")
+        return Padding::Border;
+    if (paddingMode == "reflection")
+        return Padding::Reflection;
+    OPENVINO_THROW("Unsupported GridSample padding mode: " + paddingMode);
+}
+
+// Maps a grid value from [-1, 1] to a pixel coordinate. With aligned corners -1 and 1 are centers of
+// the corner pixels, otherwise they are outer edges of the corner pixels.
+float unnormalize(float coord, size_t size, bool alignCorners) {
+    const float res = alignCorners ? 0.5f * (coord + 1) * (size - 1) : 0.5f * ((coord + 1) * size - 1);
+    return std::min(std::max(res, -maxCoordinate), maxCoordinate);
+}
+
+// Reflects a coordinate into [twiceLow / 2, twiceHigh / 2]
+float reflect(float coord, int twiceLow, int twiceHigh) {
+    if (twiceLow == twiceHigh)
+        return 0.0f;
+    const float low = twiceLow / 2.0f;
+    const float span = (twiceHigh - twiceLow) / 2.0f;
+    coord = std::fabs(coord - low);
+    const float extra = std::fmod(coord, span);
+    const int flips = static_cast<int>(std::floor(coord / span));
+    return flips % 2 == 0 ? extra + low : span - extra + low;
+}
+
+// Moves a coordinate outside of the input inside for border and reflection padding
+float pad(float coord, size_t size, const SamplingParams& params) {
+    if (params.padding == Padding::Zeros)
+        return coord;
+    if (params.padding == Padding::Reflection) {
+        const int intSize = static_cast<int>(size);
+        coord = params.alignCorners ? reflect(coord, 0, 2 * (intSize - 1)) : reflect(coord, -1, 2 * intSize - 1);
+    }
+    return std::min(std::max(coord, 0.0f), static_cast<float>(size - 1));
+}
+
+// Coordinates are clamped by unnormalize(), so they fit int
+int floorToInt(float coord) {
+    const int res = static_cast<int>(coord);
+    return res > coord ? res - 1 : res;
+}
+
+// Bicubic convolution coefficients with A = -0.75 for a fractional offset t
+void cubicCoefficients(float t, float coeffs[4]) {
+    const float A = -0.75f;
+    const auto near = [&](float x) { return ((A + 2) * x - (A + 3)) * x * x + 1; };
+    const auto far = [&](float x) { return ((A * x - 5 * A) * x + 8 * A) * x - 4 * A; };
+    coeffs[0] = far(t + 1);
+    coeffs[1] = near(t);
+    coeffs[2] = near(1 - t);
+    coeffs[3] = far(2 - t);
+}
+
+// Taps of a pixel along one axis: coordinates and weights. Coordinates outside of the input get zero weights.
+template <size_t size>
+struct AxisTaps {
+    int coords[size];
+    float weights[size];
+};
+
+template <Interpolation interpolation>
+struct InterpolationTraits;
+
+template <>
+struct InterpolationTraits<Interpolation::Nearest> {
+    static const size_t axisTaps = 1;
+    static void get(float coord, size_t size, const SamplingParams& params, AxisTaps<1>& taps) {
+        taps.coords[0] = static_cast<int>(std::nearbyint(pad(coord, size, params)));
+        taps.weights[0] = 1.0f;
+    }
+};
+
+template <>
+struct InterpolationTraits<Interpolation::Bilinear> {
+    static const size_t axisTaps = 2;
+    static void get(float coord, size_t size, const SamplingParams& params, AxisTaps<2>& taps) {
+        coord = pad(coord, size, params);
+        const int c0 = floorToInt(coord);
+        const float t = coord - c0;
+        taps.coords[0] = c0;
+        taps.coords[1] = c0 + 1;
+        taps.weights[0] = 1 - t;
+        taps.weights[1] = t;
+    }
+};
+
+template <>
+struct InterpolationTraits<Interpolation::Bicubic> {
+    static const size_t axisTaps = 4;
+    static void get(float coord, size_t size, const SamplingParams& params, AxisTaps<4>& taps) {
+        // Padding is applied to every tap instead of the sampled point
+        const int c0 = floorToInt(coord);
+        cubicCoefficients(coord - c0, taps.weights);
+        for (int i = 0; i < 4; ++i)
+            taps.coords[i] = static_cast<int>(pad(static_cast<float>(c0 - 1 + i), size, params));
+    }
+};
+
+template <Interpolation interpolation>
+void getAxisTaps(float coord, size_t size, const SamplingParams& params,
+                 AxisTaps<InterpolationTraits<interpolation>::axisTaps>& taps) {
+    InterpolationTraits<interpolation>::get(coord, size, params, taps);
+    for (size_t i = 0; i < InterpolationTraits<interpolation>::axisTaps; ++i) {
+        // Negative coordinates are out of range as unsigned values
+        if (static_cast<size_t>(taps.coords[i]) >= size) {
+            taps.coords[i] = 0;
+            taps.weights[i] = 0.0f;
+        }
+    }
+}
+
+// Taps of every output pixel are an outer product of its taps along height and width. Taps are indices
+// of pixels in an input plane. Taps outside of the input have zero weights and point to the first pixel.
+template <Interpolation interpolation>
+void computeTaps(const float* grid, size_t width, const SamplingParams& params, uint32_t* taps, float* weights) {
+    const size_t axisTaps = InterpolationTraits<interpolation>::axisTaps;
+    AxisTaps<axisTaps> tapsX, tapsY;
+    for (size_t x = 0; x < width; ++x) {
+        getAxisTaps<interpolation>(unnormalize(grid[x * 2], params.inpWidth, params.alignCorners), params.inpWidth,
+                                   params, tapsX);
+        getAxisTaps<interpolation>(unnormalize(grid[x * 2 + 1], params.inpHeight, params.alignCorners),
+                                   params.inpHeight, params, tapsY);
+        for (size_t i = 0; i < axisTaps; ++i) {
+            for (size_t j = 0; j < axisTaps; ++j) {
+                *taps++ = static_cast<uint32_t>(tapsY.coords[i] * params.inpWidth + tapsX.coords[j]);
+                *weights++ = tapsY.weights[i] * tapsX.weights[j];
+            }
+        }
+    }
+}
+
+void computeTaps(const float* grid, size_t width, const SamplingParams& params, uint32_t* taps, float* weights) {
+    switch (params.interpolation) {
+    case Interpolation::Nearest:
+        computeTaps<Interpolation::Nearest>(grid, width, params, taps, weights);
+        break;
+    case Interpolation::Bilinear:
+        computeTaps<Interpolation::Bilinear>(grid, width, params, taps, weights);
+        break;
+    case Interpolation::Bicubic:
+        computeTaps<Interpolation::Bicubic>(grid, width, params, taps, weights);
+        break;
+    }
+}
+
+// Computes taps of a grid row of any floating point type. Reduced precision rows are converted to f32 first.
+void computeGridRowTaps(const ov::Tensor& grid, size_t row, size_t width, const SamplingParams& params,
+                        uint32_t* taps, float* weights) {
+    const size_t offset = row * width * 2;
+    if (grid.get_element_type() == ov::element::f32) {
+        computeTaps(grid.data<float>() + offset, width, params, taps, weights);
+        return;
+    }
+    ScratchBuffer<float> rowGrid(scratchStats, width * 2);
+    if (grid.get_element_type() == ov::element::f16)
+        convertToFloat(grid.data<ov::float16>() + offset, rowGrid.data(), width * 2);
+    else
+        convertToFloat(grid.data<ov::bfloat16>() + offset, rowGrid.data(), width * 2);
+    computeTaps(rowGrid.data(), width, params, taps, weights);
+}
+
+// Samples a row of every channel plane from an NCHW input. Rows of reduced precision outputs are accumulated
+// in f32 buffer and converted at once.
+template <size_t numTaps, typename T>
+void sampleRowNCHW(const T* inp, const uint32_t* rowTaps, const float* rowWeights, size_t width, size_t channels,
+                   size_t inpPlane, size_t outPlane, T* out, float* buffer) {
+    const bool isFloat = std::is_same<T, float>::value;
+    for (size_t c = 0; c < channels; ++c) {
+        const T* src = inp + c * inpPlane;
+        float* dst = isFloat ? reinterpret_cast<float*>(out + c * outPlane) : buffer;
+        for (size_t x = 0; x < width; ++x) {
+            const uint32_t* taps = rowTaps + x * numTaps;
+            const float* weights = rowWeights + x * numTaps;
+            float sum = 0.0f;
+            for (size_t k = 0; k < numTaps; ++k)
+                sum += weights[k] * toFloat(src[taps[k]]);
+            dst[x] = sum;
+        }
+        if (!isFloat)
+            convertFromFloat(buffer, out + c * outPlane, width);
+    }
+}
+
+// Transposes a block of rows x cols values: dst[j * dstStride + i] = src[i * srcStride + j]
+using TransposeKernel = void (*)(const float* src, size_t srcStride, float* dst, size_t dstStride, size_t rows,
+                                 size_t cols);
+// Accumulates channel vectors of the taps of an output pixel: dst[c] = sum of weights[k] * inp[taps[k] * channels + c]
+using AccumulateKernel = void (*)(const float* inp, const uint32_t* taps, const float* weights, size_t numTaps,
+                                  size_t channels, float* dst);
+
+// Values are transposed by square tiles, so both source and destination are walked by short contiguous runs
+const size_t transposeTile = 8;
+
+void transposeRef(const float* src, size_t srcStride, float* dst, size_t dstStride, size_t rows, size_t cols) {
+    for (size_t i0 = 0; i0 < rows; i0 += transposeTile) {
+        for (size_t j0 = 0; j0 < cols; j0 += transposeTile) {
+            for (size_t i = i0; i < std::min(i0 + transposeTile, rows); ++i) {
+                for (size_t j = j0; j < std::min(j0 + transposeTile, cols); ++j)
+                    dst[j * dstStride + i] = src[i * srcStride + j];
+            }
+        }
+    }
+}
+
+void accumulateRef(const float* inp, const uint32_t* taps, const float* weights, size_t numTaps, size_t channels,
+                   float* dst) {
+    const float* src0 = inp + taps[0] * channels;
+    for (size_t c = 0; c < channels; ++c)
+        dst[c] = weights[0] * src0[c];
+    for (size_t k = 1; k < numTaps; ++k) {
+        const float* src = inp + taps[k] * channels;
+        const float w = weights[k];
+        for (size_t c = 0; c < channels; ++c)
+            dst[c] += w * src[c];
+    }
+}
+
+// Accumulates channels from first to channels one by one
+void accumulateTail(const float* inp, const uint32_t* taps, const float* weights, size_t numTaps, size_t channels,
+                    size_t first, float* dst) {
+    for (size_t c = first; c < channels; ++c) {
+        float sum = weights[0] * inp[taps[0] * channels + c];
+        for (size_t k = 1; k < numTaps; ++k)
+            sum += weights[k] * inp[taps[k] * channels + c];
+        dst[c] = sum;
+    }
+}
+
+#ifdef GRID_SAMPLE_X86
+// 8x8 tile by unpacks of row pairs, shuffles of 64-bit pairs and swaps of 128-bit halves
+__attribute__((target("avx2"))) inline void transposeTileAVX2(const float* src, size_t srcStride, float* dst,
+                                                              size_t dstStride) {
+    __m256 r[8], t[8];
+    for (size_t i = 0; i < 8; ++i)
+        r[i] = _mm256_loadu_ps(src + i * srcStride);
+    for (size_t i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+    for (size_t i = 0; i < 8; i += 4) {
+        r[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+        r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xEE);
+        r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+        r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xEE);
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        _mm256_storeu_ps(dst + i * dstStride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+        _mm256_storeu_ps(dst + (i + 4) * dstStride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+    }
+}
+
+__attribute__((target("avx2"))) void transposeAVX2(const float* src, size_t srcStride, float* dst, size_t dstStride,
+                                                   size_t rows, size_t cols) {
+    const size_t fullRows = rows / transposeTile * transposeTile;
+    const size_t fullCols = cols / transposeTile * transposeTile;
+    for (size_t i = 0; i < fullRows; i += transposeTile) {
+        for (size_t j = 0; j < fullCols; j += transposeTile)
+            transposeTileAVX2(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride);
+    }
+    transposeRef(src + fullCols, srcStride, dst + fullCols * dstStride, dstStride, fullRows, cols - fullCols);
+    transposeRef(src + fullRows * srcStride, srcStride, dst + fullRows, dstStride, rows - fullRows, cols);
+}
+
+// Every block of 8 channels stays in a register while all the taps are accumulated
+__attribute__((target("avx2,fma"))) void accumulateAVX2(const float* inp, const uint32_t* taps, const float* weights,
+                                                        size_t numTaps, size_t channels, float* dst) {
+    size_t c = 0;
+    for (; c + 8 <= channels; c += 8) {
+        __m256 sum = _mm256_mul_ps(_mm256_set1_ps(weights[0]), _mm256_loadu_ps(inp + taps[0] * channels + c));
+        for (size_t k = 1; k < numTaps; ++k)
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(inp + taps[k] * channels + c), sum);
+        _mm256_storeu_ps(dst + c, sum);
+    }
+    accumulateTail(inp, taps, weights, numTaps, channels, c, dst);
+}
+#endif
+
+#ifdef GRID_SAMPLE_NEON
+// 4x4 tile by transposes of 2x2 blocks of row pairs and combination of their halves
+inline void transposeTileNEON(const float* src, size_t srcStride, float* dst, size_t dstStride) {
+    const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(src), vld1q_f32(src + srcStride));
+    const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(src + 2 * srcStride), vld1q_f32(src + 3 * srcStride));
+    vst1q_f32(dst, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+    vst1q_f32(dst + dstStride, vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+    vst1q_f32(dst + 2 * dstStride, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+    vst1q_f32(dst + 3 * dstStride, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+}
+
+void transposeNEON(const float* src, size_t srcStride, float* dst, size_t dstStride, size_t rows, size_t cols) {
+    const size_t fullRows = rows / 4 * 4;
+    const size_t fullCols = cols / 4 * 4;
+    for (size_t i = 0; i < fullRows; i += 4) {
+        for (size_t j = 0; j < fullCols; j += 4)
+            transposeTileNEON(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride);
+    }
+    transposeRef(src + fullCols, srcStride, dst + fullCols * dstStride, dstStride, fullRows, cols - fullCols);
+    transposeRef(src + fullRows * srcStride, srcStride, dst + fullRows, dstStride, rows - fullRows, cols);
+}
+
+void accumulateNEON(const float* inp, const uint32_t* taps, const float* weights, size_t numTaps, size_t channels,
+                    float* dst) {
+    size_t c = 0;
+    for (; c + 4 <= channels; c += 4) {
+        float32x4_t sum = vmulq_n_f32(vld1q_f32(inp + taps[0] * channels + c), weights[0]);
+        for (size_t k = 1; k < numTaps; ++k)
+            sum = vmlaq_n_f32(sum, vld1q_f32(inp + taps[k] * channels + c), weights[k]);
+        vst1q_f32(dst + c, sum);
+    }
+    accumulateTail(inp, taps, weights, numTaps, channels, c, dst);
+}
+#endif
+
+struct GridSampleKernels {
+    TransposeKernel transpose;
+    AccumulateKernel accumulate;
+};
+
+// Kernels are selected once for the instruction set of the host CPU
+const GridSampleKernels& getKernels() {
+    static const GridSampleKernels kernels = []() -> GridSampleKernels {
+#if defined(GRID_SAMPLE_X86)
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return {transposeAVX2, accumulateAVX2};
+#elif defined(GRID_SAMPLE_NEON)
+        return {transposeNEON, accumulateNEON};
+#endif
+        return {transposeRef, accumulateRef};
+    }();
+    return kernels;
+}
+
+// Input in NHWC layout whose rows are transposed on demand. Tasks of output rows transpose the input rows
+// which their taps read right before sampling them, so a row is converted while it is hot in cache and rows
+// which no tap reads are not converted at all. Both the data and the row states are scratch buffers of
+// the thread which calls evaluate. The data is f32 for every input type.
+template <typename T>
+class NHWCInput {
+public:
+    NHWCInput(const T* inp, size_t batch, size_t channels, size_t inpHeight, size_t inpWidth)
+        : inp(inp),
+          channels(channels),
+          inpHeight(inpHeight),
+          inpWidth(inpWidth),
+          data(scratchStats, batch * channels * inpHeight * inpWidth),
+          states(scratchStats, batch * inpHeight) {
+        for (size_t i = 0; i < batch * inpHeight; ++i)
+            new (&states[i]) std::atomic<uint8_t>(rowEmpty);
+    }
+
+    const float* image(size_t b) const {
+        return data.data() + b * channels * inpHeight * inpWidth;
+    }
+
+    // Makes input rows read by taps of an image available. Taps outside of the input point to the first pixel,
+    // so the first row is requested separately from the range of the other rows.
+    void prepareRows(size_t b, const uint32_t* taps, size_t numTaps) {
+        size_t first = inpHeight, last = 0;
+        bool firstPixel = false;
+        for (size_t k = 0; k < numTaps; ++k) {
+            if (taps[k] == 0) {
+                firstPixel = true;
+                continue;
+            }
+            const size_t y = taps[k] / inpWidth;
+            first = std::min(first, y);
+            last = std::max(last, y);
+        }
+        if (firstPixel)
+            prepareRow(b * inpHeight);
+        for (size_t y = first; y <= last; ++y)
+            prepareRow(b * inpHeight + y);
+    }
+
+private:
+    enum : uint8_t { rowEmpty, rowBusy, rowReady };
+
+    void prepareRow(size_t row) {
+        std::atomic<uint8_t>& state = states[row];
+        if (state.load(std::memory_order_acquire) == rowReady)
+            return;
+        uint8_t expected = rowEmpty;
+        if (state.compare_exchange_strong(expected, rowBusy, std::memory_order_acquire)) {
+            transposeRow(row);
+            state.store(rowReady, std::memory_order_release);
+            return;
+        }
+        // Another task transposes the row and does not wait for anything
+        while (state.load(std::memory_order_acquire) != rowReady)
+            std::this_thread::yield();
+    }
+
+    // Reduced precision channel rows are converted to f32 before they are transposed
+    void transposeRow(size_t row) {
+        ProfileScope scope(transposePhase);
+        const size_t inpPlane = inpHeight * inpWidth;
+        const T* src = inp + row / inpHeight * channels * inpPlane + row % inpHeight * inpWidth;
+        float* dst = data.data() + row * inpWidth * channels;
+        if (std::is_same<T, float>::value) {
+            getKernels().transpose(reinterpret_cast<const float*>(src), inpPlane, dst, channels, channels, inpWidth);
+            return;
+        }
+        ScratchBuffer<float> rows(scratchStats, channels * inpWidth);
+        for (size_t c = 0; c < channels; ++c)
+            convertToFloat(src + c * inpPlane, rows.data() + c * inpWidth, inpWidth);
+        getKernels().transpose(rows.data(), inpWidth, dst, channels, channels, inpWidth);
+    }
+
+    const T* inp;
+    size_t channels, inpHeight, inpWidth;
+    ScratchBuffer<float> data;
+    ScratchBuffer<std::atomic<uint8_t>> states;
+};
+
+// Samples a row from an NHWC input. Every output pixel accumulates contiguous channel vectors of
+// its taps in a row buffer, which is then transposed to NCHW output. For reduced precision outputs
+// the channel rows are transposed to f32 and converted at once.
+template <size_t numTaps, typename T>
+void sampleRowNHWC(const float* inp, const uint32_t* rowTaps, const float* rowWeights, size_t width, size_t channels,
+                   size_t outPlane, T* out, float* buffer) {
+    const GridSampleKernels& kernels = getKernels();
+    for (size_t x = 0; x < width; ++x) {
+        kernels.accumulate(inp, rowTaps + x * numTaps, rowWeights + x * numTaps, numTaps, channels,
+                           buffer + x * channels);
+    }
+    if (std::is_same<T, float>::value) {
+        kernels.transpose(buffer, channels, reinterpret_cast<float*>(out), outPlane, width, channels);
+        return;
+    }
+    ScratchBuffer<float> rows(scratchStats, channels * width);
+    kernels.transpose(buffer, channels, rows.data(), width, width, channels);
+    for (size_t c = 0; c < channels; ++c)
+        convertFromFloat(rows.data() + c * width, out + c * outPlane, width);
+}
+
+// An NHWC input is always f32, an NCHW input has the type of the output
+template <size_t numTaps, typename T>
+void sampleRow(bool nhwc, const float* nhwcInp, const T* inp, const uint32_t* taps, const float* weights,
+               size_t width, size_t channels, size_t inpPlane, size_t outPlane, T* out) {
+    ScratchBuffer<float> buffer(scratchStats, nhwc ? width * channels : std::is_same<T, float>::value ? 0 : width);
+    if (nhwc)
+        sampleRowNHWC<numTaps>(nhwcInp, taps, weights, width, channels, outPlane, out, buffer.data());
+    else
+        sampleRowNCHW<numTaps>(inp, taps, weights, width, channels, inpPlane, outPlane, out, buffer.data());
+}
+
+template <typename T>
+void sampleGrid(const ov::Tensor& input, const ov::Tensor& grid, ov::Tensor& output, const SamplingParams& params,
+                const uint32_t* planTaps, const float* planWeights) {
+    const T* inpData = input.data<T>();
+    T* outData = output.data<T>();
+
+    const ov::Shape& outDims = output.get_shape();
+    const size_t batch     = outDims[0];
+    const size_t channels  = outDims[1];
+    const size_t height    = outDims[2];
+    const size_t width     = outDims[3];
+    const size_t inpPlane  = params.inpHeight * params.inpWidth;
+    const size_t outPlane  = height * width;
+    const size_t numTaps = params.numTaps();
+
+    // Input with many channels is transposed to NHWC so that taps are read as contiguous vectors
+    const bool nhwc = channels >= nhwcMinChannels;
+    std::unique_ptr<NHWCInput<T>> nhwcInput(
+        nhwc ? new NHWCInput<T>(inpData, batch, channels, params.inpHeight, params.inpWidth) : nullptr);
+
+    // Every task samples a single output row. Taps and weights are computed once per pixel and
+    // reused for all the channels. A constant grid reuses taps and weights between calls.
+    parallelFor(opThreads, batch * height, [&](size_t d) {
+        const size_t b = d / height;
+        const size_t y = d % height;
+        ScratchBuffer<uint32_t> rowTaps(scratchStats, planTaps ? 0 : width * numTaps);
+        ScratchBuffer<float> rowWeights(scratchStats, planTaps ? 0 : width * numTaps);
+        const uint32_t* taps = rowTaps.data();
+        const float* weights = rowWeights.data();
+        if (planTaps) {
+            taps = planTaps + d * width * numTaps;
+            weights = planWeights + d * width * numTaps;
+        } else {
+            ProfileScope scope(tapsPhase);
+            computeGridRowTaps(grid, d, width, params, rowTaps.data(), rowWeights.data());
+        }
+
+        if (nhwc)
+            nhwcInput->prepareRows(b, taps, width * numTaps);
+        ProfileScope scope(samplePhase);
+        const float* nhwcInp = nhwc ? nhwcInput->image(b) : nullptr;
+        const T* inp = inpData + b * channels * inpPlane;
+        T* out = outData + b * channels * outPlane + y * width;
+        switch (numTaps) {
+        case 1:
+            sampleRow<1>(nhwc, nhwcInp, inp, taps, weights, width, channels, inpPlane, outPlane, out);
+            break;
+        case 4:
+            sampleRow<4>(nhwc, nhwcInp, inp, taps, weights, width, channels, inpPlane, outPlane, out);
+            break;
+        default:
+            sampleRow<16>(nhwc, nhwcInp, inp, taps, weights, width, channels, inpPlane, outPlane, out);
+            break;
+        }
+    });
+}
+
+}  // namespace
+
+struct GridSample::Plan {
+    size_t inpHeight, inpWidth;
+    std::vector<uint32_t> taps;
+    std::vector<float> weights;
+};
+
+GridSample::GridSample(const ov::OutputVector& args,
+                       const std::string& mode,
+                       const std::string& padding_mode,
+                       bool align_corners)
+    : Op(args), mode(mode), padding_mode(padding_mode), align_corners(align_corners) {
     constructor_validate_and_infer_types();
 }
 
 void GridSample::validate_and_infer_types() {
+    getInterpolation(mode);
+    getPadding(padding_mode);
+
     auto outShape = get_input_partial_shape(0);  // NC
     // Grid input has a shape NxHxWx2
     auto gridShape = get_input_partial_shape(1);
     outShape[2] = gridShape[1];  // H
     outShape[3] = gridShape[2];  // W
     set_output_type(0, get_input_element_type(0), outShape);
+
+    // Inputs or attributes might be changed
+    std::lock_guard<std::mutex> lock(planMutex);
+    plan.reset();
+}
+
+// Returns a plan for a constant grid or nullptr for a grid which can change between calls.
+// The plan is built by the first call and rebuilt only if input spatial dimensions change.
+std::shared_ptr<const GridSample::Plan> GridSample::getConstantGridPlan(const ov::Tensor& grid,
+                                                                       size_t inpHeight,
+                                                                       size_t inpWidth) const {
+    if (!ov::as_type_ptr<ov::op::v0::Constant>(input_value(1).get_node_shared_ptr()))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(planMutex);
+    if (plan && plan->inpHeight == inpHeight && plan->inpWidth == inpWidth)
+        return plan;
+
+    const SamplingParams params{getInterpolation(mode), getPadding(padding_mode), align_corners, inpHeight, inpWidth};
+    const size_t numTaps = params.numTaps();
+    const ov::Shape& gridShape = grid.get_shape();
+    const size_t rows = gridShape[0] * gridShape[1];
+    const size_t width = gridShape[2];
+    auto newPlan = std::make_shared<Plan>();
+    newPlan->inpHeight = inpHeight;
+    newPlan->inpWidth = inpWidth;
+    newPlan->taps.resize(rows * width * numTaps);
+    newPlan->weights.resize(rows * width * numTaps);
+    ProfileScope scope(tapsPhase);
+    parallelFor(opThreads, rows, [&](size_t row) {
+        computeGridRowTaps(grid, row, width, params, newPlan->taps.data() + row * width * numTaps,
+                           newPlan->weights.data() + row * width * numTaps);
+    });
+    plan = newPlan;
+    return plan;
 }
 
 std::shared_ptr<ov::Node> GridSample::clone_with_new_inputs(const ov::OutputVector& new_args) const {
     OPENVINO_ASSERT(new_args.size() == 2, "Incorrect number of new arguments");
-    return std::make_shared<GridSample>(new_args);
+    return std::make_shared<GridSample>(new_args, mode, padding_mode, align_corners);
 }
 
-bool GridSample::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
-    const float* inpData  = reinterpret_cast<float*>(inputs[0].data());
-    const float* gridData = reinterpret_cast<float*>(inputs[1].data());
-    float* outData = reinterpret_cast<float*>(outputs[0].data());
+bool GridSample::visit_attributes(ov::AttributeVisitor& visitor) {
+    int align_corners_i = static_cast<int>(align_corners);
+    visitor.on_attribute("mode", mode);
+    visitor.on_attribute("padding_mode", padding_mode);
+    visitor.on_attribute("align_corners", align_corners_i);
+    align_corners = static_cast<bool>(align_corners_i);
+    return true;
+}
 
+bool GridSample::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
     std::vector<size_t> inpDims = inputs[0].get_shape();
-    std::vector<size_t> outDims = outputs[0].get_shape();
-
-    const size_t batch     = outDims[0];
-    const size_t channels  = outDims[1];
-    const size_t height    = outDims[2];
-    const size_t width     = outDims[3];
     const size_t inpHeight = inpDims[2];
     const size_t inpWidth  = inpDims[3];
-    const size_t inpPlane  = inpHeight * inpWidth;
-    const size_t outPlane  = height * width;
+    OPENVINO_ASSERT(inpHeight * inpWidth <= std::numeric_limits<uint32_t>::max(),
+                    "GridSample input plane is too large");
 
-    std::vector<float> zerosPlane(inpDims[1] * inpDims[2] * inpDims[3], 0);
-    float* zeros = zerosPlane.data();
-
-    ov::parallel_for(batch, [&](size_t d) {
-        const float* inp  = inpData + d * channels * inpPlane;
-        const float* grid = gridData + d * outPlane * 2;
-        for (size_t y = 0; y < height; ++y) {
-            for (size_t x = 0; x < width; ++x) {
-                size_t offset = y * width + x;
-
-                float input_x = 0.5f * (grid[offset * 2] + 1) * (inpWidth - 1);
-                int x0 = static_cast<int>(std::floor(input_x));
-                int x1 = x0 + 1;
-
-                float input_y = 0.5f * (grid[offset * 2 + 1] + 1) * (inpHeight - 1);
-                int y0 = static_cast<int>(std::floor(input_y));
-                int y1 = y0 + 1;
-
-                const float* inp_row0 = (0 <= y0 && y0 < inpHeight) ? inp + y0 * inpWidth : zeros;
-                const float* inp_row1 = (0 <= y1 && y1 < inpHeight) ? inp + y1 * inpWidth : zeros;
-                float* out = outData + d * channels * outPlane;
-                if ((x1 < 0 || inpWidth <= x1) && (x0 < 0 || inpWidth <= x0)) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = 0;
-                        out += outPlane;
-                    }
-                }
-                else if (x1 < 0 || inpWidth <= x1) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x0] - inp_row0[x0]) +
-                            (input_x - x0) * (-inp_row0[x0] +
-                            (input_y - y0) * (inp_row0[x0] - inp_row1[x0]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                }
-                else if (x0 < 0 || inpWidth <= x0) {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] =
-                            (input_x - x0) * (inp_row0[x1] + (input_y - y0) * (inp_row1[x1] - inp_row0[x1]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                } else {
-                    for (size_t c = 0; c < channels; ++c) {
-                        out[offset] = inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x0] - inp_row0[x0]) +
-                            (input_x - x0) * (inp_row0[x1] - inp_row0[x0] +
-                            (input_y - y0) * (inp_row1[x1] - inp_row0[x1] - inp_row1[x0] + inp_row0[x0]));
-                        out += outPlane;
-                        inp_row0 += inpPlane;
-                        inp_row1 += inpPlane;
-                    }
-                }
-            }
-        }
-    });
+    ProfileScope scope(totalPhase);
+    const SamplingParams params{getInterpolation(mode), getPadding(padding_mode), align_corners, inpHeight, inpWidth};
+    const std::shared_ptr<const Plan> constantPlan = getConstantGridPlan(inputs[1], inpHeight, inpWidth);
+    const uint32_t* planTaps = constantPlan ? constantPlan->taps.data() : nullptr;
+    const float* planWeights = constantPlan ? constantPlan->weights.data() : nullptr;
+    switch (inputs[0].get_element_type()) {
+    case ov::element::f32:
+        sampleGrid<float>(inputs[0], inputs[1], outputs[0], params, planTaps, planWeights);
+        break;
+    case ov::element::f16:
+        sampleGrid<ov::float16>(inputs[0], inputs[1], outputs[0], params, planTaps, planWeights);
+        break;
+    case ov::element::bf16:
+        sampleGrid<ov::bfloat16>(inputs[0], inputs[1], outputs[0], params, planTaps, planWeights);
+        break;
+    default:
+        OPENVINO_THROW("Unexpected input type: " + inputs[0].get_element_type().to_string());
+    }
     return true;
 }
 
 bool GridSample::has_evaluate() const {
+    // Input and grid are f32, f16 or bf16. Their types might differ.
     for (size_t i = 0; i < get_input_size(); ++i)
-        if (get_input_element_type(i) != ov::element::f32)
+        if (!isEvaluatedFloatType(get_input_element_type(i)))
             return false;
     return true;
 }
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <string>
+
 #include <openvino/op/op.hpp>
 
 namespace TemplateExtension {
@@ -13,12 +16,31 @@ public:
     OPENVINO_OP("GridSample");
 
     GridSample() = default;
-    GridSample(const ov::OutputVector& new_args);
+    GridSample(const ov::OutputVector& new_args,
+               const std::string& mode = "bilinear",
+               const std::string& padding_mode = "zeros",
+               bool align_corners = true);
     void validate_and_infer_types() override;
     std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+    bool visit_attributes(ov::AttributeVisitor& visitor) override;
 
     bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
     bool has_evaluate() const override;
+
+private:
+    // Interpolation: nearest, bilinear or bicubic
+    std::string mode = "bilinear";
+    // Values outside of the input: zeros, border or reflection
+    std::string padding_mode = "zeros";
+    // Grid values -1 and 1 correspond to centers of the corner pixels if true or to their outer edges otherwise
+    bool align_corners = true;
+
+    // Taps and weights of all the output pixels. They are computed once if the grid is a constant.
+    struct Plan;
+    std::shared_ptr<const Plan> getConstantGridPlan(const ov::Tensor& grid, size_t inpHeight, size_t inpWidth) const;
+
+    mutable std::shared_ptr<const Plan> plan;
+    mutable std::mutex planMutex;
 };
 
 }  // namespace TemplateExtension
@@ -4,58 +4,270 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#    include <string_view>
+#    define OPENVINO_EXTENSIONS_STRING_VIEW
+#endif
+
 #include <openvino/runtime/tensor.hpp>
 
 namespace openvino_extensions {
+
+// Packed string tensors have one of two layouts:
+// - offsets32: int32_t batch size, int32_t begin offset of the first string, int32_t end offsets of every string
+//   and then symbols of all the strings without separators. It is limited by 2 GB of symbols.
+// - offsets64: int32_t marker -1, int32_t version 2, uint64_t batch size, uint64_t begin offset of the first string,
+//   uint64_t end offsets of every string and then symbols. Negative batch size of the first layout makes them
+//   distinguishable, and offsets are 8-byte aligned, so large packed corpora can be mapped to memory and
+//   wrapped by ov::Tensor as is.
+// Offsets are counted from the beginning of the symbols. Unpacking detects the layout.
+enum class packed_strings_format { automatic, offsets32, offsets64 };
+
+namespace detail {
+
+const int32_t packed_strings_offsets64_marker = -1;
+const int32_t packed_strings_offsets64_version = 2;
+const size_t packed_strings_offsets64_header_size = 16;
+
+template <typename BatchOfStrings>
+size_t get_symbols_size(const BatchOfStrings& strings) {
+    return std::accumulate(
+        strings.begin(), strings.end(), size_t(0),
+        [](size_t accum, typename BatchOfStrings::const_reference str)
+        { return accum + str.size(); });
+}
+
+// Offsets and the size of the whole 32-bit layout are int32_t values
+inline bool fits_offsets32(size_t batch_size, size_t symbols_size) {
+    const size_t max_size = size_t(std::numeric_limits<int32_t>::max());
+    return batch_size <= max_size / 4 - 2 && symbols_size <= max_size - 4 * (1 + 1 + batch_size);
+}
+
+// The 32-bit layout is used if both the batch and symbols fit it
+inline packed_strings_format select_format(packed_strings_format format, size_t batch_size, size_t symbols_size) {
+    if (format != packed_strings_format::automatic)
+        return format;
+    return fits_offsets32(batch_size, symbols_size) ? packed_strings_format::offsets32
+                                                    : packed_strings_format::offsets64;
+}
+
+inline size_t get_header_size(packed_strings_format format) {
+    return format == packed_strings_format::offsets64 ? packed_strings_offsets64_header_size : 4;
+}
+
+inline size_t get_offset_size(packed_strings_format format) {
+    return format == packed_strings_format::offsets64 ? 8 : 4;
+}
+
+// Writes offsets after a header and symbols in a single pass
+template <typename Offset, typename BatchOfStrings>
+void pack_offsets_and_symbols(const BatchOfStrings& strings, uint8_t* data, size_t header_size) {
+    Offset* pindices = reinterpret_cast<Offset*>(data + header_size);
+    pindices[0] = 0;
+    Offset* end_ids = pindices + 1;
+    char* psymbols = reinterpret_cast<char*>(end_ids + strings.size());
+    char* current_symbols = psymbols;
+    for (const auto& str : strings) {
+        current_symbols = std::copy(str.begin(), str.end(), current_symbols);
+        *end_ids++ = Offset(current_symbols - psymbols);
+    }
+}
+
+}  // namespace detail
+
+// Returns a number of bytes required to pack the strings
+template <typename BatchOfStrings>
+size_t get_packed_strings_size(const BatchOfStrings& strings,
+                               packed_strings_format format = packed_strings_format::automatic) {
+    const size_t symbols_size = detail::get_symbols_size(strings);
+    format = detail::select_format(format, strings.size(), symbols_size);
+    return detail::get_header_size(format) + detail::get_offset_size(format) * (1 + strings.size()) + symbols_size;
+}
+
+// Packs strings into memory of a preallocated tensor with element type u8 without reshaping it.
+// The tensor must have at least get_packed_strings_size(strings, format) bytes. Returns a number of written bytes.
+// Sizes are checked before anything is written, then offsets and symbols are written in a single pass,
+// so no intermediate buffers are used.
+template <typename BatchOfStrings>
+size_t pack_strings_to(const BatchOfStrings& strings, ov::Tensor& destination,
+                       packed_strings_format format = packed_strings_format::automatic) {
+    const size_t batch_size = strings.size();
+    const size_t symbols_size = detail::get_symbols_size(strings);
+    format = detail::select_format(format, batch_size, symbols_size);
+    OPENVINO_ASSERT(format == packed_strings_format::offsets64 || detail::fits_offsets32(batch_size, symbols_size),
+                    "Strings are too large for the packed string tensor with 32-bit offsets");
+
+    const size_t header_size = detail::get_header_size(format);
+    const size_t total_size = header_size + detail::get_offset_size(format) * (1 + batch_size) + symbols_size;
+    OPENVINO_ASSERT(destination.get_byte_size() >= total_size, "Packed string tensor is too small for the batch");
+
+    uint8_t* data = destination.data<uint8_t>();
+    if (format == packed_strings_format::offsets64) {
+        int32_t* pmarker = reinterpret_cast<int32_t*>(data);
+        pmarker[0] = detail::packed_strings_offsets64_marker;
+        pmarker[1] = detail::packed_strings_offsets64_version;
+        reinterpret_cast<uint64_t*>(data)[1] = uint64_t(batch_size);
+        detail::pack_offsets_and_symbols<uint64_t>(strings, data, header_size);
+    } else {
+        reinterpret_cast<int32_t*>(data)[0] = int32_t(batch_size);
+        detail::pack_offsets_and_symbols<int32_t>(strings, data, header_size);
+    }
+    return total_size;
+}
+
 // Pack any container with string to ov::Tensor with element type u8
 // Requirements for BatchOfStrings: .size() with size and .begin(), .end() as iterators, elements with .begin(), .end() and .size()
 // so basically any STL container with std::string is compatible
 // Tensor destination will be reshaped according the input data
 template <typename BatchOfStrings>
-void pack_strings(const BatchOfStrings& strings, ov::Tensor& destination) {
-    size_t batch_size = strings.size();
+void pack_strings(const BatchOfStrings& strings, ov::Tensor& destination,
+                  packed_strings_format format = packed_strings_format::automatic) {
+    if (format == packed_strings_format::automatic)
+        format = detail::select_format(format, strings.size(), detail::get_symbols_size(strings));
+    destination.set_shape({get_packed_strings_size(strings, format)});
+    pack_strings_to(strings, destination, format);
+}
 
-    // First run over all elements: calculate total memory required to hold all strings
-    size_t symbols_size = std::accumulate(
-        strings.begin(), strings.end(), size_t(0),
-        [](size_t accum, typename BatchOfStrings::const_reference str)
-        { return accum + str.size(); });
+namespace detail {
 
-    size_t total_size = 4 * (1 + 1 + batch_size) + symbols_size;
-    destination.set_shape({total_size});
+struct packed_strings_layout {
+    size_t batch_size;
+    // Begin offset of the first string followed by end offsets of every string
+    const void* offsets;
+    bool offsets64;
+    const char* symbols;
 
-    int32_t* pindices = reinterpret_cast<int32_t*>(destination.data<uint8_t>());
-    pindices[0] = int32_t(batch_size);
-    pindices[1] = 0;
-    pindices += 2;
-    char* psymbols = reinterpret_cast<char*>(pindices + batch_size);
-    size_t current_symbols_pos = 0;
+    size_t get_offset(size_t idx) const {
+        return offsets64 ? size_t(static_cast<const uint64_t*>(offsets)[idx])
+                         : size_t(static_cast<const int32_t*>(offsets)[idx]);
+    }
 
-    for (const auto& str: strings) {
-        psymbols = std::copy(str.begin(), str.end(), psymbols);
-        current_symbols_pos += str.size();
-        *pindices = int32_t(current_symbols_pos);
-        ++pindices;
+    size_t get_begin(size_t idx) const {
+        return get_offset(idx);
     }
-}
 
-std::vector<std::string> unpack_strings(const ov::Tensor& source) {
+    size_t get_end(size_t idx) const {
+        return get_offset(idx + 1);
+    }
+};
+
+inline packed_strings_layout get_packed_strings_layout(const ov::Tensor& source) {
     size_t length = source.get_byte_size();
     // check the format of the input bitstream representing the string tensor
     OPENVINO_ASSERT(length >= 4, "Incorrect packed string tensor format: no batch size in the packed string tensor");
-    const int32_t* pindices = reinterpret_cast<const int32_t*>(source.data<const uint8_t>());
-    int32_t batch_size = pindices[0];
-    OPENVINO_ASSERT(int32_t(length) >= 4 + 4 + 4 * batch_size,
-        "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
-    const int32_t* begin_ids = pindices + 1;
-    const int32_t* end_ids = pindices + 2;
-    const char* symbols = reinterpret_cast<const char*>(pindices + 2 + batch_size);
+    const uint8_t* data = source.data<const uint8_t>();
+    const int32_t* pindices = reinterpret_cast<const int32_t*>(data);
+
+    packed_strings_layout layout;
+    size_t offsets_begin = 4;
+    if (pindices[0] == packed_strings_offsets64_marker) {
+        OPENVINO_ASSERT(length >= packed_strings_offsets64_header_size &&
+                        pindices[1] == packed_strings_offsets64_version,
+                        "Incorrect packed string tensor format: unsupported version of the packed string tensor");
+        const uint64_t batch_size = reinterpret_cast<const uint64_t*>(data)[1];
+        offsets_begin = packed_strings_offsets64_header_size;
+        OPENVINO_ASSERT(batch_size < (length - offsets_begin) / 8,
+            "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
+        layout.batch_size = size_t(batch_size);
+        layout.offsets64 = true;
+    } else {
+        OPENVINO_ASSERT(pindices[0] >= 0 && size_t(pindices[0]) < (length - offsets_begin) / 4,
+            "Incorrect packed string tensor format: the packed string tensor must contain first string offset and end indices");
+        layout.batch_size = size_t(pindices[0]);
+        layout.offsets64 = false;
+    }
+
+    const size_t offsets_size = (layout.offsets64 ? 8 : 4) * (layout.batch_size + 1);
+    layout.offsets = data + offsets_begin;
+    layout.symbols = reinterpret_cast<const char*>(data + offsets_begin + offsets_size);
+    const size_t symbols_size = length - offsets_begin - offsets_size;
+    OPENVINO_ASSERT(layout.batch_size == 0 || layout.get_end(layout.batch_size - 1) <= symbols_size,
+                    "Incorrect packed string tensor format: offsets exceed the packed string tensor");
+    return layout;
+}
+
+}  // namespace detail
+
+inline std::vector<std::string> unpack_strings(const ov::Tensor& source) {
+    const detail::packed_strings_layout layout = detail::get_packed_strings_layout(source);
 
     std::vector<std::string> result;
-    result.reserve(size_t(batch_size));
-    for (int32_t idx = 0; idx < batch_size; ++idx) {
-        result.emplace_back(symbols + begin_ids[idx], symbols + end_ids[idx]);
+    result.reserve(layout.batch_size);
+    for (size_t idx = 0; idx < layout.batch_size; ++idx) {
+        result.emplace_back(layout.symbols + layout.get_begin(idx), layout.symbols + layout.get_end(idx));
     }
     return result;
 }
+
+#ifdef OPENVINO_EXTENSIONS_STRING_VIEW
+// Random access range of strings of a packed string tensor. Strings point into the tensor memory,
+// so the tensor must outlive the range and its strings.
+class packed_string_views {
+public:
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef std::string_view reference;
+
+        const_iterator() = default;
+        const_iterator(const detail::packed_strings_layout& layout, size_t idx) : layout(layout), idx(idx) {}
+
+        std::string_view operator*() const { return get_string_view(layout, idx); }
+        std::string_view operator[](difference_type n) const { return get_string_view(layout, idx + n); }
+        const_iterator& operator++() { ++idx; return *this; }
+        const_iterator operator++(int) { const_iterator res = *this; ++idx; return res; }
+        const_iterator& operator--() { --idx; return *this; }
+        const_iterator operator--(int) { const_iterator res = *this; --idx; return res; }
+        const_iterator& operator+=(difference_type n) { idx += n; return *this; }
+        const_iterator& operator-=(difference_type n) { idx -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(layout, idx + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(layout, idx - n); }
+        difference_type operator-(const const_iterator& other) const { return difference_type(idx) - difference_type(other.idx); }
+        bool operator==(const const_iterator& other) const { return idx == other.idx; }
+        bool operator!=(const const_iterator& other) const { return idx != other.idx; }
+        bool operator<(const const_iterator& other) const { return idx < other.idx; }
+
+    private:
+        detail::packed_strings_layout layout = {};
+        size_t idx = 0;
+    };
+
+    typedef std::string_view value_type;
+    typedef std::string_view const_reference;
+
+    explicit packed_string_views(const detail::packed_strings_layout& layout) : layout(layout) {}
+
+    size_t size() const { return layout.batch_size; }
+    bool empty() const { return layout.batch_size == 0; }
+
+    std::string_view operator[](size_t idx) const { return get_string_view(layout, idx); }
+
+    const_iterator begin() const { return const_iterator(layout, 0); }
+    const_iterator end() const { return const_iterator(layout, size()); }
+
+private:
+    static std::string_view get_string_view(const detail::packed_strings_layout& layout, size_t idx) {
+        return std::string_view(layout.symbols + layout.get_begin(idx), layout.get_end(idx) - layout.get_begin(idx));
+    }
+
+    detail::packed_strings_layout layout;
+};
+
+// Unpacks strings without copying them. The result can be packed again by pack_strings() and pack_strings_to().
+inline packed_string_views unpack_string_views(const ov::Tensor& source) {
+    return packed_string_views(detail::get_packed_strings_layout(source));
+}
+#endif
 }
@@ -0,0 +1,63 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace TemplateExtension {
+
+// Number of bits per coordinate in a 64-bit Morton code
+const int mortonCoordBits = 21;
+
+// Spreads the low 21 bits of v so that there are two zero bits between every two bits
+inline uint64_t spreadMortonBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+inline uint64_t compactMortonBits(uint64_t v) {
+    v &= 0x1249249249249249ull;
+    v = (v ^ (v >> 2)) & 0x10c30c30c30c30c3ull;
+    v = (v ^ (v >> 4)) & 0x100f00f00f00f00full;
+    v = (v ^ (v >> 8)) & 0x1f0000ff0000ffull;
+    v = (v ^ (v >> 16)) & 0x1f00000000ffffull;
+    v = (v ^ (v >> 32)) & 0x1fffff;
+    return v;
+}
+
+// Z-order key of non-negative coordinates which fit mortonCoordBits. Bits of x are the most significant ones
+// of every triple, so points of the same cube of size 2^k are contiguous in the order of keys.
+inline uint64_t encodeMorton(uint64_t x, uint64_t y, uint64_t z) {
+    return (spreadMortonBits(x) << 2) | (spreadMortonBits(y) << 1) | spreadMortonBits(z);
+}
+
+inline void decodeMorton(uint64_t key, uint64_t coords[3]) {
+    coords[0] = compactMortonBits(key >> 2);
+    coords[1] = compactMortonBits(key >> 1);
+    coords[2] = compactMortonBits(key);
+}
+
+// Compares non-negative coordinates of any size in the order of Morton codes without computing them.
+// The coordinate with the highest differing bit decides, and x wins ties as the most significant one.
+inline bool mortonLess(const int64_t a[3], const int64_t b[3]) {
+    int dim = 0;
+    uint64_t maxDiff = 0;
+    for (int k = 0; k < 3; ++k) {
+        const uint64_t diff = static_cast<uint64_t>(a[k] ^ b[k]);
+        // Highest bit of diff is higher than the one of maxDiff
+        if (maxDiff < diff && maxDiff < (maxDiff ^ diff)) {
+            dim = k;
+            maxDiff = diff;
+        }
+    }
+    return a[dim] < b[dim];
+}
+
+}  // namespace TemplateExtension
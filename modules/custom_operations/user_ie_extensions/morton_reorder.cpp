@@ -0,0 +1,145 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "morton_reorder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <openvino/core/parallel.hpp>
+
+#include "morton_code.hpp"
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "row_splits.hpp"
+#include "scratch_arena.hpp"
+
+using namespace TemplateExtension;
+
+namespace {
+
+ScratchStats& scratchStats = getScratchStats("MortonReorder");
+OpThreads& opThreads = getOpThreads("MortonReorder");
+ProfilePhase& totalPhase = getProfilePhase("MortonReorder", "total");
+ProfilePhase& sortPhase = getProfilePhase("MortonReorder", "sort");
+// Copies of positions and features in the sorted order
+ProfilePhase& gatherPhase = getProfilePhase("MortonReorder", "gather");
+
+struct KeyIndex {
+    uint64_t key;
+    size_t index;
+    bool operator<(const KeyIndex& other) const {
+        return key < other.key || (key == other.key && index < other.index);
+    }
+};
+
+// Writes indices of points [begin, end) to order sorted by Morton codes of their voxels.
+// Voxels are counted from the minimal coordinates of the cloud, so negative positions are supported.
+void sortCloud(const float* pos, size_t begin, size_t end, size_t* order) {
+    if (begin == end)
+        return;
+    float minPos[3] = {pos[begin * 3], pos[begin * 3 + 1], pos[begin * 3 + 2]};
+    float maxPos[3] = {minPos[0], minPos[1], minPos[2]};
+    for (size_t i = begin; i < end; ++i) {
+        for (size_t k = 0; k < 3; ++k) {
+            minPos[k] = std::min(minPos[k], pos[i * 3 + k]);
+            maxPos[k] = std::max(maxPos[k], pos[i * 3 + k]);
+        }
+    }
+    auto getVoxel = [&](size_t i, int64_t voxel[3]) {
+        for (size_t k = 0; k < 3; ++k)
+            voxel[k] = static_cast<int64_t>(std::floor(pos[i * 3 + k] - minPos[k]));
+    };
+
+    const float maxExtent = std::max(std::max(maxPos[0] - minPos[0], maxPos[1] - minPos[1]), maxPos[2] - minPos[2]);
+    const size_t size = end - begin;
+    if (maxExtent < static_cast<float>(int64_t(1) << mortonCoordBits)) {
+        ScratchBuffer<KeyIndex> keys(scratchStats, size);
+        int64_t voxel[3];
+        for (size_t i = 0; i < size; ++i) {
+            getVoxel(begin + i, voxel);
+            keys[i] = KeyIndex{encodeMorton(voxel[0], voxel[1], voxel[2]), begin + i};
+        }
+        std::sort(keys.data(), keys.data() + size);
+        for (size_t i = 0; i < size; ++i)
+            order[begin + i] = keys[i].index;
+        return;
+    }
+
+    // Extents which do not fit a Morton code are compared by coordinates
+    ScratchBuffer<std::array<int64_t, 3>> voxels(scratchStats, size);
+    for (size_t i = 0; i < size; ++i)
+        getVoxel(begin + i, voxels[i].data());
+    for (size_t i = 0; i < size; ++i)
+        order[begin + i] = begin + i;
+    std::stable_sort(order + begin, order + end, [&](size_t a, size_t b) {
+        return mortonLess(voxels[a - begin].data(), voxels[b - begin].data());
+    });
+}
+
+}  // namespace
+
+MortonReorder::MortonReorder(const ov::OutputVector& args) : Op(args) {
+    constructor_validate_and_infer_types();
+}
+
+void MortonReorder::validate_and_infer_types() {
+    OPENVINO_ASSERT(get_input_size() == 2 || get_input_size() == 3,
+                    "MortonReorder expects positions, features and optional row splits inputs");
+    set_output_type(0, get_input_element_type(0), get_input_partial_shape(0));
+    set_output_type(1, get_input_element_type(1), get_input_partial_shape(1));
+    set_output_type(2, ov::element::i64, ov::PartialShape{get_input_partial_shape(0)[0]});
+}
+
+std::shared_ptr<ov::Node> MortonReorder::clone_with_new_inputs(const ov::OutputVector& new_args) const {
+    OPENVINO_ASSERT(new_args.size() == 2 || new_args.size() == 3, "Incorrect number of new arguments");
+    return std::make_shared<MortonReorder>(new_args);
+}
+
+bool MortonReorder::evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const {
+    ProfileScope scope(totalPhase);
+    const float* pos = inputs[0].data<float>();
+    const float* features = inputs[1].data<float>();
+    const size_t numPoints = inputs[0].get_shape()[0];
+    const size_t numChannels = inputs[1].get_size() / std::max<size_t>(numPoints, 1);
+    OPENVINO_ASSERT(inputs[1].get_shape()[0] == numPoints, "MortonReorder expects features of every point");
+
+    // Points after the terminator of a single cloud are not sorted
+    const size_t numSorted = inputs.size() > 2 ? getNumClouds(inputs[2]) : 1;
+    ScratchBuffer<size_t> splits(scratchStats, numSorted + 1);
+    if (inputs.size() > 2) {
+        readRowSplits(inputs[2], numPoints, splits.data());
+    } else {
+        splits[0] = 0;
+        splits[1] = countValidPoints(pos, numPoints);
+    }
+
+    ScratchBuffer<size_t> order(scratchStats, numPoints);
+    for (size_t i = splits[numSorted]; i < numPoints; ++i)
+        order[i] = i;
+    {
+        ProfileScope sortScope(sortPhase);
+        parallelFor(opThreads, numSorted, [&](size_t c) {
+            sortCloud(pos, splits[c], splits[c + 1], order.data());
+        });
+    }
+
+    float* outPos = outputs[0].data<float>();
+    float* outFeatures = outputs[1].data<float>();
+    int64_t* indices = outputs[2].data<int64_t>();
+    ProfileScope gatherScope(gatherPhase);
+    parallelFor(opThreads, numPoints, [&](size_t i) {
+        const size_t j = order[i];
+        std::copy_n(pos + j * 3, 3, outPos + i * 3);
+        std::copy_n(features + j * numChannels, numChannels, outFeatures + i * numChannels);
+        indices[j] = static_cast<int64_t>(i);
+    });
+    return true;
+}
+
+bool MortonReorder::has_evaluate() const {
+    return get_input_element_type(0) == ov::element::f32 && get_input_element_type(1) == ov::element::f32 &&
+           (get_input_size() == 2 || isRowSplitsType(get_input_element_type(2)));
+}
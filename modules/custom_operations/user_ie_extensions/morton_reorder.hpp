@@ -0,0 +1,29 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <openvino/op/op.hpp>
+
+namespace TemplateExtension {
+
+// Sorts points of a cloud and their features in Z-order of Morton codes of unit voxels, so neighbors found by
+// SparseConv are close in memory. Inputs: positions [N, 3], features [N, C] and optional row splits [B + 1]
+// of a batch of clouds, which are sorted independently. Without row splits positions are terminated by a negative
+// coordinate and the points after it keep their places. Outputs are sorted positions and features and indices
+// [N] which restore the original order by Gather: original[i] = sorted[indices[i]].
+class MortonReorder : public ov::op::Op {
+public:
+    OPENVINO_OP("MortonReorder");
+
+    MortonReorder() = default;
+    MortonReorder(const ov::OutputVector& args);
+    void validate_and_infer_types() override;
+    std::shared_ptr<ov::Node> clone_with_new_inputs(const ov::OutputVector& new_args) const override;
+
+    bool evaluate(ov::TensorVector& outputs, const ov::TensorVector& inputs) const override;
+    bool has_evaluate() const override;
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,169 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#ifdef USER_OV_EXTENSIONS_ITT
+#    include <ittnotify.h>
+#endif
+
+// Time spent by operations in phases of their evaluate calls, such as neighbor search or GEMM of SparseConv.
+// Counters are collected when profiling is enabled by USER_OV_EXTENSIONS_PROFILE environment variable or by
+// the library API. Builds with ITT also mark every phase as a task for VTune, whether counters are enabled or not.
+
+namespace TemplateExtension {
+
+// Name of the environment variable with a path of a JSON file. If it is set, counters are enabled and written
+// to the file when the library is unloaded.
+const char* const profileEnvVariable = "USER_OV_EXTENSIONS_PROFILE";
+
+// Number of calls of a phase and its total time. Phases inside parallel regions are measured by every thread,
+// so their time is a sum over threads and may exceed the wall time of the whole evaluate.
+struct ProfilePhase {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> nanoseconds{0};
+#ifdef USER_OV_EXTENSIONS_ITT
+    __itt_string_handle* ittName = nullptr;
+#endif
+};
+
+struct ProfileRegistry {
+    ProfileRegistry() {
+        const char* path = std::getenv(profileEnvVariable);
+        enabled = path != nullptr && path[0] != '\0';
+    }
+
+    std::mutex mutex;
+    std::atomic<bool> enabled{false};
+    // Phases of operation types in the order of names
+    std::map<std::string, std::map<std::string, std::unique_ptr<ProfilePhase>>> ops;
+};
+
+inline ProfileRegistry& getProfileRegistry() {
+    static ProfileRegistry registry;
+    return registry;
+}
+
+#ifdef USER_OV_EXTENSIONS_ITT
+inline __itt_domain* getIttDomain() {
+    static __itt_domain* domain = __itt_domain_create("user_ov_extensions");
+    return domain;
+}
+#endif
+
+// Returns a phase of an operation type. The reference stays valid while the library is loaded, so operations
+// keep references to their phases in static variables.
+inline ProfilePhase& getProfilePhase(const std::string& opType, const std::string& phase) {
+    ProfileRegistry& registry = getProfileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::unique_ptr<ProfilePhase>& stats = registry.ops[opType][phase];
+    if (!stats) {
+        stats.reset(new ProfilePhase());
+#ifdef USER_OV_EXTENSIONS_ITT
+        stats->ittName = __itt_string_handle_create((opType + "::" + phase).c_str());
+#endif
+    }
+    return *stats;
+}
+
+inline bool isProfilingEnabled() {
+    return getProfileRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+inline void setProfilingEnabled(bool enabled) {
+    getProfileRegistry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+inline void resetProfile() {
+    ProfileRegistry& registry = getProfileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& op : registry.ops) {
+        for (auto& phase : op.second) {
+            phase.second->calls.store(0, std::memory_order_relaxed);
+            phase.second->nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Counters of phases which were called at least once:
+// {"SparseConv": {"total": {"calls": 2, "ns": 1520000}, "gemm": {"calls": 16, "ns": 980000}}}
+inline std::string getProfileJson() {
+    ProfileRegistry& registry = getProfileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::ostringstream json;
+    json << "{";
+    bool firstOp = true;
+    for (const auto& op : registry.ops) {
+        bool firstPhase = true;
+        for (const auto& phase : op.second) {
+            const uint64_t calls = phase.second->calls.load(std::memory_order_relaxed);
+            if (calls == 0)
+                continue;
+            if (firstPhase) {
+                json << (firstOp ? "" : ", ") << "\"" << op.first << "\": {";
+                firstOp = false;
+            }
+            json << (firstPhase ? "" : ", ") << "\"" << phase.first << "\": {\"calls\": " << calls
+                 << ", \"ns\": " << phase.second->nanoseconds.load(std::memory_order_relaxed) << "}";
+            firstPhase = false;
+        }
+        if (!firstPhase)
+            json << "}";
+    }
+    json << "}";
+    return json.str();
+}
+
+// Measures a phase from construction to destruction. The clock is not read while profiling is disabled.
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase& phase) : phase(phase), enabled(isProfilingEnabled()) {
+#ifdef USER_OV_EXTENSIONS_ITT
+        domain = getIttDomain();
+        if (domain && domain->flags)
+            __itt_task_begin(domain, __itt_null, __itt_null, phase.ittName);
+        else
+            domain = nullptr;
+#endif
+        if (enabled)
+            start = std::chrono::steady_clock::now();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ~ProfileScope() {
+        if (enabled) {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            phase.calls.fetch_add(1, std::memory_order_relaxed);
+            phase.nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                        std::memory_order_relaxed);
+        }
+#ifdef USER_OV_EXTENSIONS_ITT
+        if (domain)
+            __itt_task_end(domain);
+#endif
+    }
+
+private:
+    ProfilePhase& phase;
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+#ifdef USER_OV_EXTENSIONS_ITT
+    // Domain of a started task
+    __itt_domain* domain;
+#endif
+};
+
+}  // namespace TemplateExtension
@@ -0,0 +1,107 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <openvino/core/parallel.hpp>
+
+// Thread limits of operations. Parallel regions run in the task arena of the calling thread, which is the arena
+// of an inference stream with its number of threads and CPU affinity, so several streams do not share threads.
+// The limits additionally cap threads of operation types, e.g. to leave cores of a stream to other nodes.
+
+namespace TemplateExtension {
+
+// Name of the environment variable with limits which are set when the library is loaded: a limit of all the
+// operations and limits of operation types, e.g. "8" or "8,SparseConv:4,FFT:2"
+const char* const maxThreadsEnvVariable = "USER_OV_EXTENSIONS_MAX_THREADS";
+
+// Thread limit of an operation type. Zero means no limit.
+struct OpThreads {
+    std::atomic<int> maxThreads{0};
+
+    // Returns a number of threads which operations of the type use at most
+    int getMaxThreads() const;
+};
+
+struct ThreadsRegistry {
+    ThreadsRegistry() {
+        const char* limits = std::getenv(maxThreadsEnvVariable);
+        const std::string value = limits ? limits : "";
+        for (size_t begin = 0; begin < value.size();) {
+            size_t end = value.find(',', begin);
+            if (end == std::string::npos)
+                end = value.size();
+            const std::string item = value.substr(begin, end - begin);
+            const size_t colon = item.find(':');
+            if (colon == std::string::npos) {
+                maxThreads = std::max(0, std::atoi(item.c_str()));
+            } else {
+                std::unique_ptr<OpThreads>& op = ops[item.substr(0, colon)];
+                op.reset(new OpThreads());
+                op->maxThreads = std::max(0, std::atoi(item.c_str() + colon + 1));
+            }
+            begin = end + 1;
+        }
+    }
+
+    std::mutex mutex;
+    // Limit of all the operations
+    std::atomic<int> maxThreads{0};
+    std::map<std::string, std::unique_ptr<OpThreads>> ops;
+};
+
+inline ThreadsRegistry& getThreadsRegistry() {
+    static ThreadsRegistry registry;
+    return registry;
+}
+
+// Returns the thread limit of an operation type. The reference stays valid while the library is loaded.
+inline OpThreads& getOpThreads(const std::string& opType) {
+    ThreadsRegistry& registry = getThreadsRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::unique_ptr<OpThreads>& threads = registry.ops[opType];
+    if (!threads)
+        threads.reset(new OpThreads());
+    return *threads;
+}
+
+inline void setMaxThreads(int maxThreads) {
+    getThreadsRegistry().maxThreads.store(std::max(0, maxThreads), std::memory_order_relaxed);
+}
+
+inline int OpThreads::getMaxThreads() const {
+    int threads = ov::parallel_get_max_threads();
+    const int opLimit = maxThreads.load(std::memory_order_relaxed);
+    const int limit = getThreadsRegistry().maxThreads.load(std::memory_order_relaxed);
+    if (opLimit > 0)
+        threads = std::min(threads, opLimit);
+    if (limit > 0)
+        threads = std::min(threads, limit);
+    return std::max(threads, 1);
+}
+
+// ov::parallel_for limited by the threads of an operation type. Without a limit below the size of the arena
+// work is split by ov::parallel_for as before, otherwise every thread processes a contiguous range.
+template <typename F>
+void parallelFor(const OpThreads& threads, size_t size, const F& func) {
+    const int maxThreads = threads.getMaxThreads();
+    if (maxThreads >= ov::parallel_get_max_threads()) {
+        ov::parallel_for(size, func);
+        return;
+    }
+    const int nthr = static_cast<int>(std::min<size_t>(static_cast<size_t>(maxThreads), std::max<size_t>(size, 1)));
+    ov::parallel_nt(nthr, [&](const int ithr, const int nthr) {
+        ov::for_1d(ithr, nthr, size, func);
+    });
+}
+
+}  // namespace TemplateExtension
@@ -2,11 +2,29 @@
 // SPDX-License-Identifier: Apache-2.0
 //
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
 #include <openvino/core/extension.hpp>
 #include <openvino/core/op_extension.hpp>
 #include <openvino/frontend/extension.hpp>
 #include <openvino/frontend/node_context.hpp>
 
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "scratch_arena.hpp"
+
+#ifdef bpe_tokenizer
+#    include "bpe_tokenizer.hpp"
+#    define BPE_TOKENIZER_EXT                                                                           \
+            std::make_shared<ov::OpExtension<TemplateExtension::BPETokenizer>>(),                       \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::BPETokenizer>>(),
+#else
+#    define BPE_TOKENIZER_EXT
+#endif
+
 #ifdef calculate_grid
 #    include "calculate_grid.hpp"
 #    define CALCULATE_GRID_EXT                                                                          \
@@ -25,6 +43,15 @@
 #    define COMPLEX_MUL_EXT
 #endif
 
+#ifdef detokenizer
+#    include "detokenizer.hpp"
+#    define DETOKENIZER_EXT                                                                            \
+            std::make_shared<ov::OpExtension<TemplateExtension::Detokenizer>>(),                       \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::Detokenizer>>(),
+#else
+#    define DETOKENIZER_EXT
+#endif
+
 #ifdef fft
 #    include "fft.hpp"
 #    define FFT_EXT                                                                                    \
@@ -34,6 +61,50 @@
 #    define FFT_EXT
 #endif
 
+#ifdef fft_convolution
+#    include <openvino/pass/manager.hpp>
+#    include "fft_convolution.hpp"
+#    define FFT_CONV_OP_EXT                                                                            \
+            std::make_shared<ov::OpExtension<TemplateExtension::FFTConvolution>>(),                    \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::FFTConvolution>>(),
+#else
+#    define FFT_CONV_OP_EXT
+#endif
+
+// Fusion of FFT -> ComplexMultiplication -> inverse FFT is applied to models read by frontends
+#if defined(fft_convolution) && defined(fft) && defined(complex_mul)
+#    define FFT_CONV_FUSION_EXT                                                                        \
+            std::make_shared<ov::frontend::DecoderTransformationExtension>(                            \
+                [](std::shared_ptr<ov::Model> model) {                                                 \
+                    ov::pass::Manager manager;                                                         \
+                    manager.register_pass<TemplateExtension::FFTConvolutionFusion>();                  \
+                    manager.run_passes(model);                                                         \
+                    return true;                                                                       \
+                }),
+#else
+#    define FFT_CONV_FUSION_EXT
+#endif
+
+#define FFT_CONV_EXT FFT_CONV_OP_EXT FFT_CONV_FUSION_EXT
+
+#ifdef grid_sample
+#    include "grid_sample.hpp"
+#    define GRID_SAMPLE_EXT                                                                            \
+            std::make_shared<ov::OpExtension<TemplateExtension::GridSample>>(),                        \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::GridSample>>(),
+#else
+#    define GRID_SAMPLE_EXT
+#endif
+
+#ifdef morton_reorder
+#    include "morton_reorder.hpp"
+#    define MORTON_REORDER_EXT                                                                         \
+            std::make_shared<ov::OpExtension<TemplateExtension::MortonReorder>>(),                     \
+            std::make_shared<ov::frontend::OpExtension<TemplateExtension::MortonReorder>>(),
+#else
+#    define MORTON_REORDER_EXT
+#endif
+
 #ifdef sparse_conv_transpose
 #    include "sparse_conv_transpose.hpp"
 #    define S_CONV_TRANSPOSE_EXT                                                                      \
@@ -54,9 +125,82 @@
 
 OPENVINO_CREATE_EXTENSIONS(std::vector<ov::Extension::Ptr>(
     {
+        BPE_TOKENIZER_EXT
         CALCULATE_GRID_EXT
+        DETOKENIZER_EXT
         FFT_EXT
+        FFT_CONV_EXT
+        GRID_SAMPLE_EXT
+        MORTON_REORDER_EXT
         S_CONV_TRANSPOSE_EXT
         S_CONV_EXT
         COMPLEX_MUL_EXT
     }));
+
+// Peak number of scratch bytes held at once by operations of a given type, such as "GridSample",
+// since the library was loaded or peaks were reset
+OPENVINO_EXTENSION_C_API size_t user_ov_extensions_get_peak_scratch_bytes(const char* op_type) {
+    return TemplateExtension::getScratchStats(op_type).peak.load();
+}
+
+// Also returns free scratch blocks of every thread to the heap when the thread releases its next block
+OPENVINO_EXTENSION_C_API void user_ov_extensions_reset_peak_scratch_bytes() {
+    TemplateExtension::resetScratchPeaks();
+}
+
+// Sets the number of bytes of free scratch blocks which every thread keeps for next evaluate calls, unlimited
+// by default. Blocks above the limit are returned to the heap when evaluate finishes. Returns the previous limit.
+OPENVINO_EXTENSION_C_API size_t user_ov_extensions_set_scratch_retain_limit(size_t bytes) {
+    return TemplateExtension::setScratchRetainLimit(bytes);
+}
+
+namespace {
+
+// Writes profile counters to the file named by USER_OV_EXTENSIONS_PROFILE when the library is unloaded
+struct ProfileDump {
+    ProfileDump() {
+        // The registry is created before the dump, so it is destroyed after it
+        TemplateExtension::getProfileRegistry();
+    }
+
+    ~ProfileDump() {
+        const char* path = std::getenv(TemplateExtension::profileEnvVariable);
+        if (path == nullptr || path[0] == '\0')
+            return;
+        std::ofstream file(path);
+        file << TemplateExtension::getProfileJson() << std::endl;
+    }
+} profileDump;
+
+}  // namespace
+
+// Enables or disables counters of time spent by operations in phases of evaluate calls, such as "neighbor_search"
+// and "gemm" of SparseConv. Counters are enabled at load time if USER_OV_EXTENSIONS_PROFILE is set.
+OPENVINO_EXTENSION_C_API void user_ov_extensions_set_profiling(int enabled) {
+    TemplateExtension::setProfilingEnabled(enabled != 0);
+}
+
+// Writes counters of operations as a JSON object to a buffer of size bytes, including the terminating zero.
+// Returns the length of the JSON object, so the buffer is large enough if the result is less than size.
+OPENVINO_EXTENSION_C_API size_t user_ov_extensions_get_profile_json(char* buffer, size_t size) {
+    const std::string json = TemplateExtension::getProfileJson();
+    if (buffer != nullptr && size > 0) {
+        const size_t length = std::min(json.size(), size - 1);
+        std::memcpy(buffer, json.data(), length);
+        buffer[length] = '\0';
+    }
+    return json.size();
+}
+
+OPENVINO_EXTENSION_C_API void user_ov_extensions_reset_profile() {
+    TemplateExtension::resetProfile();
+}
+
+// Limits the number of threads of operations of a given type, such as "SparseConv", or of all the operations if
+// op_type is null. Zero removes the limit. Operations never use more threads than the arena of the calling stream.
+OPENVINO_EXTENSION_C_API void user_ov_extensions_set_max_threads(const char* op_type, int max_threads) {
+    if (op_type == nullptr)
+        TemplateExtension::setMaxThreads(max_threads);
+    else
+        TemplateExtension::getOpThreads(op_type).maxThreads.store(std::max(0, max_threads));
+}
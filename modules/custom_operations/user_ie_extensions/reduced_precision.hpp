@@ -0,0 +1,203 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <openvino/core/type/bfloat16.hpp>
+#include <openvino/core/type/element_type.hpp>
+#include <openvino/core/type/float16.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define REDUCED_PRECISION_X86
+#    include <immintrin.h>
+#endif
+
+// Loads and stores of f16 and bf16 tensors. Operations compute in f32 and convert values of reduced precision
+// on the fly, so tensors are not converted as a whole and keep half of the memory traffic.
+
+namespace TemplateExtension {
+
+// Floating point element types which have evaluate paths
+inline bool isEvaluatedFloatType(const ov::element::Type& type) {
+    return type == ov::element::f32 || type == ov::element::f16 || type == ov::element::bf16;
+}
+
+inline float toFloat(float v) {
+    return v;
+}
+
+// Exponent is rebiased with integer operations, so subnormal values survive denormals-are-zero mode of the CPU
+inline float toFloat(ov::float16 v) {
+    const uint32_t half = v.to_bits();
+    const uint32_t exponent = half & 0x7c00;
+    const uint32_t magnitude = (half & 0x7fff) << 13;
+    uint32_t bits;
+    if (exponent == 0x7c00) {
+        // Infinities and NaNs
+        bits = magnitude | 0x7f800000;
+    } else if (exponent != 0) {
+        bits = magnitude + (112u << 23);
+    } else {
+        // Subnormal values are multiples of 2^-24
+        const float subnormal = static_cast<float>(half & 0x3ff) * 5.9604644775390625e-08f;
+        std::memcpy(&bits, &subnormal, sizeof(bits));
+    }
+    bits |= (half & 0x8000) << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// bf16 is the upper half of f32
+inline float toFloat(ov::bfloat16 v) {
+    const uint32_t bits = static_cast<uint32_t>(v.to_bits()) << 16;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+template <typename T>
+T fromFloat(float v);
+
+template <>
+inline float fromFloat<float>(float v) {
+    return v;
+}
+
+template <>
+inline ov::float16 fromFloat<ov::float16>(float v) {
+    return ov::float16(v);
+}
+
+// Rounds to nearest even. NaNs stay quiet NaNs instead of being rounded to infinities.
+inline uint16_t roundToBFloat16Bits(uint32_t bits) {
+    if ((bits & 0x7fffffff) > 0x7f800000)
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    return static_cast<uint16_t>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+}
+
+template <>
+inline ov::bfloat16 fromFloat<ov::bfloat16>(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return ov::bfloat16::from_bits(roundToBFloat16Bits(bits));
+}
+
+namespace detail {
+
+template <typename T>
+void convertToFloatRef(const T* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = toFloat(src[i]);
+}
+
+template <typename T>
+void convertFromFloatRef(const float* src, T* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = fromFloat<T>(src[i]);
+}
+
+#ifdef REDUCED_PRECISION_X86
+__attribute__((target("avx2,f16c"))) inline void convertF16ToFloatF16C(const ov::float16* src, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    convertToFloatRef(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2,f16c"))) inline void convertFloatToF16F16C(const float* src, ov::float16* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+    }
+    convertFromFloatRef(src + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline void convertBF16ToFloatAVX2(const ov::bfloat16* src, float* dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+    }
+    convertToFloatRef(src + i, dst + i, n - i);
+}
+
+// Vectorized roundToBFloat16Bits. Packing works within 128-bit lanes, so the halves are permuted back in order.
+__attribute__((target("avx2"))) inline void convertFloatToBF16AVX2(const float* src, ov::bfloat16* dst, size_t n) {
+    const __m256i absMask = _mm256_set1_epi32(0x7fffffff);
+    const __m256i infinity = _mm256_set1_epi32(0x7f800000);
+    const __m256i quietBit = _mm256_set1_epi32(0x00400000);
+    const __m256i bias = _mm256_set1_epi32(0x7fff);
+    const __m256i one = _mm256_set1_epi32(1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(src + i));
+        const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        const __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(bias, lsb));
+        const __m256i isNaN = _mm256_cmpgt_epi32(_mm256_and_si256(bits, absMask), infinity);
+        const __m256i res = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, _mm256_or_si256(bits, quietBit), isNaN), 16);
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_castsi256_si128(packed));
+    }
+    convertFromFloatRef(src + i, dst + i, n - i);
+}
+#endif
+
+template <typename T>
+struct Converters {
+    void (*toFloat)(const T* src, float* dst, size_t n);
+    void (*fromFloat)(const float* src, T* dst, size_t n);
+};
+
+// Converters are selected once for the instruction set of the host CPU
+inline const Converters<ov::float16>& getConverters(const ov::float16*) {
+    static const Converters<ov::float16> converters = []() -> Converters<ov::float16> {
+#ifdef REDUCED_PRECISION_X86
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c"))
+            return {convertF16ToFloatF16C, convertFloatToF16F16C};
+#endif
+        return {convertToFloatRef<ov::float16>, convertFromFloatRef<ov::float16>};
+    }();
+    return converters;
+}
+
+inline const Converters<ov::bfloat16>& getConverters(const ov::bfloat16*) {
+    static const Converters<ov::bfloat16> converters = []() -> Converters<ov::bfloat16> {
+#ifdef REDUCED_PRECISION_X86
+        if (__builtin_cpu_supports("avx2"))
+            return {convertBF16ToFloatAVX2, convertFloatToBF16AVX2};
+#endif
+        return {convertToFloatRef<ov::bfloat16>, convertFromFloatRef<ov::bfloat16>};
+    }();
+    return converters;
+}
+
+}  // namespace detail
+
+// Converts n contiguous elements to f32
+inline void convertToFloat(const float* src, float* dst, size_t n) {
+    std::copy(src, src + n, dst);
+}
+
+template <typename T>
+void convertToFloat(const T* src, float* dst, size_t n) {
+    detail::getConverters(src).toFloat(src, dst, n);
+}
+
+// Converts n contiguous f32 elements with rounding to nearest even
+inline void convertFromFloat(const float* src, float* dst, size_t n) {
+    std::copy(src, src + n, dst);
+}
+
+template <typename T>
+void convertFromFloat(const float* src, T* dst, size_t n) {
+    detail::getConverters(static_cast<const T*>(nullptr)).fromFloat(src, dst, n);
+}
+
+}  // namespace TemplateExtension
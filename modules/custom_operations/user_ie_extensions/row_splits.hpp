@@ -0,0 +1,49 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include <openvino/runtime/tensor.hpp>
+
+namespace TemplateExtension {
+
+// Returns a number of valid points in positions tensor. Points list is terminated by a negative coordinate.
+inline size_t countValidPoints(const float* pos, size_t numPoints) {
+    for (size_t i = 0; i < numPoints; ++i) {
+        if (pos[i * 3] < 0)
+            return i;
+    }
+    return numPoints;
+}
+
+// Returns a number of clouds of row splits. There is one split more than clouds.
+inline size_t getNumClouds(const ov::Tensor& tensor) {
+    OPENVINO_ASSERT(tensor.get_shape().size() == 1 && tensor.get_size() >= 1,
+                    "Row splits must be a 1D tensor with at least one element");
+    return tensor.get_size() - 1;
+}
+
+// Reads row splits of a batch of point clouds: cloud c consists of points [splits[c], splits[c + 1]).
+// splits has getNumClouds(tensor) + 1 elements.
+inline void readRowSplits(const ov::Tensor& tensor, size_t numPoints, size_t* splits) {
+    const size_t numSplits = getNumClouds(tensor) + 1;
+    for (size_t c = 0; c < numSplits; ++c) {
+        const int64_t split = tensor.get_element_type() == ov::element::i32 ? tensor.data<int32_t>()[c]
+                                                                            : tensor.data<int64_t>()[c];
+        OPENVINO_ASSERT(split >= 0 && static_cast<size_t>(split) <= numPoints &&
+                        (c == 0 || static_cast<size_t>(split) >= splits[c - 1]),
+                        "Row splits must be non-decreasing offsets of points");
+        splits[c] = static_cast<size_t>(split);
+    }
+    OPENVINO_ASSERT(splits[0] == 0 && splits[numSplits - 1] == numPoints, "Row splits must cover all the points");
+}
+
+// Returns true if the optional inputs of row splits have integer element types
+inline bool isRowSplitsType(const ov::element::Type& type) {
+    return type == ov::element::i32 || type == ov::element::i64;
+}
+
+}  // namespace TemplateExtension
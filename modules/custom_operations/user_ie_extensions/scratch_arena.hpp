@@ -0,0 +1,290 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace TemplateExtension {
+
+// Scratch memory held by operations of one type. Blocks are counted with their rounded up sizes.
+struct ScratchStats {
+    std::atomic<size_t> inUse{0};
+    std::atomic<size_t> peak{0};
+
+    void acquire(size_t bytes) {
+        const size_t used = inUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t prev = peak.load(std::memory_order_relaxed);
+        while (used > prev && !peak.compare_exchange_weak(prev, used, std::memory_order_relaxed)) {
+        }
+    }
+
+    void release(size_t bytes) {
+        inUse.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+};
+
+struct ScratchRegistry {
+    std::mutex mutex;
+    std::map<std::string, std::unique_ptr<ScratchStats>> stats;
+};
+
+inline ScratchRegistry& getScratchRegistry() {
+    static ScratchRegistry registry;
+    return registry;
+}
+
+// Returns statistics of an operation type. The reference stays valid while the library is loaded.
+inline ScratchStats& getScratchStats(const std::string& opType) {
+    ScratchRegistry& registry = getScratchRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::unique_ptr<ScratchStats>& stats = registry.stats[opType];
+    if (!stats)
+        stats.reset(new ScratchStats());
+    return *stats;
+}
+
+// Generation of peak measurements. Arenas compare it with the generation of their free blocks.
+inline std::atomic<size_t>& getScratchGeneration() {
+    static std::atomic<size_t> generation(0);
+    return generation;
+}
+
+// Starts a new measurement of peaks from the memory which is currently in use. Free blocks kept by arenas
+// belong to the previous measurement, so every arena frees them when it releases its next block.
+inline void resetScratchPeaks() {
+    ScratchRegistry& registry = getScratchRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& it : registry.stats)
+        it.second->peak.store(it.second->inUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    getScratchGeneration().fetch_add(1, std::memory_order_relaxed);
+}
+
+// Free bytes which every thread may keep for next evaluate calls. There is no limit by default.
+inline std::atomic<size_t>& getScratchRetainLimit() {
+    static std::atomic<size_t> limit(std::numeric_limits<size_t>::max());
+    return limit;
+}
+
+// Sets the limit of free bytes kept by every thread and returns the previous one. Arenas of other threads
+// follow a lower limit when they release their next block.
+inline size_t setScratchRetainLimit(size_t bytes) {
+    return getScratchRetainLimit().exchange(bytes, std::memory_order_relaxed);
+}
+
+// Thread-local cache of scratch blocks. Sizes are rounded up to powers of two and released blocks are kept
+// in free lists of their size classes, so repeated evaluate calls with the same shapes reuse the blocks of
+// previous calls and do not touch the heap. A block is allocated only when its free list is empty, so every
+// class keeps no more blocks than the thread has held at once, and the kept memory follows the observed peak
+// of the thread rather than a fixed size. The free blocks are returned to the heap when peaks are reset or
+// when they exceed the retain limit, starting from the largest ones.
+class ScratchArena {
+public:
+    static ScratchArena& local() {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+
+    ScratchArena() : generation(getScratchGeneration().load(std::memory_order_relaxed)) {}
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    ~ScratchArena() {
+        trim(0);
+    }
+
+    static size_t getClass(size_t bytes) {
+        size_t cls = 0;
+        while ((minBlockSize << cls) < bytes)
+            ++cls;
+        return cls;
+    }
+
+    static size_t getClassSize(size_t cls) {
+        return minBlockSize << cls;
+    }
+
+    void* acquire(size_t cls) {
+        std::vector<void*>& blocks = freeBlocks[cls];
+        if (!blocks.empty()) {
+            void* block = blocks.back();
+            blocks.pop_back();
+            retainedBytes -= getClassSize(cls);
+            return block;
+        }
+        void* block = std::malloc(getClassSize(cls));
+        if (!block)
+            throw std::bad_alloc();
+        return block;
+    }
+
+    void release(size_t cls, void* block) {
+        const size_t current = getScratchGeneration().load(std::memory_order_relaxed);
+        if (current != generation) {
+            trim(0);
+            generation = current;
+        }
+        freeBlocks[cls].push_back(block);
+        retainedBytes += getClassSize(cls);
+        trim(getScratchRetainLimit().load(std::memory_order_relaxed));
+    }
+
+    // Frees the largest free blocks until at most limit bytes are kept
+    void trim(size_t limit) {
+        for (size_t cls = numClasses; cls-- > 0 && retainedBytes > limit;) {
+            std::vector<void*>& blocks = freeBlocks[cls];
+            while (!blocks.empty() && retainedBytes > limit) {
+                std::free(blocks.back());
+                blocks.pop_back();
+                retainedBytes -= getClassSize(cls);
+            }
+        }
+    }
+
+private:
+    static const size_t minBlockSize = 64;
+    static const size_t numClasses = sizeof(size_t) * 8 - 6;
+
+    std::vector<void*> freeBlocks[numClasses];
+    // Total size of free blocks
+    size_t retainedBytes = 0;
+    // Generation of peak measurements which the free blocks belong to
+    size_t generation;
+};
+
+// Uninitialized buffer of trivial elements taken from the arena of the calling thread. The buffer must be
+// destroyed by the same thread, so buffers are declared in evaluate() or in bodies of parallel tasks.
+template <typename T>
+class ScratchBuffer {
+public:
+    ScratchBuffer(ScratchStats& stats, size_t count)
+        : stats(stats),
+          arena(ScratchArena::local()),
+          cls(ScratchArena::getClass(count * sizeof(T))),
+          count(count),
+          ptr(static_cast<T*>(arena.acquire(cls))) {
+        stats.acquire(ScratchArena::getClassSize(cls));
+    }
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ~ScratchBuffer() {
+        arena.release(cls, ptr);
+        stats.release(ScratchArena::getClassSize(cls));
+    }
+
+    T* data() const {
+        return ptr;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    T& operator[](size_t i) const {
+        return ptr[i];
+    }
+
+private:
+    ScratchStats& stats;
+    ScratchArena& arena;
+    size_t cls;
+    size_t count;
+    T* ptr;
+};
+
+// Growable array of trivial elements for temporaries whose size is known only after they are filled. A full
+// array moves to a block of the next size class. The same thread rule as for ScratchBuffer applies.
+template <typename T>
+class ScratchVector {
+public:
+    explicit ScratchVector(ScratchStats& stats) : stats(stats), arena(ScratchArena::local()) {}
+
+    ScratchVector(const ScratchVector&) = delete;
+    ScratchVector& operator=(const ScratchVector&) = delete;
+
+    ~ScratchVector() {
+        if (ptr)
+            release();
+    }
+
+    void push_back(const T& value) {
+        if (count == capacity)
+            grow(count + 1);
+        ptr[count++] = value;
+    }
+
+    void append(const T* first, const T* last) {
+        const size_t num = static_cast<size_t>(last - first);
+        if (count + num > capacity)
+            grow(count + num);
+        std::copy(first, last, ptr + count);
+        count += num;
+    }
+
+    // Drops the elements and keeps the block for next ones
+    void clear() {
+        count = 0;
+    }
+
+    T* data() const {
+        return ptr;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    T* begin() const {
+        return ptr;
+    }
+
+    T* end() const {
+        return ptr + count;
+    }
+
+    T& operator[](size_t i) const {
+        return ptr[i];
+    }
+
+private:
+    void grow(size_t minCount) {
+        size_t newCls = ptr ? cls + 1 : 0;
+        while (ScratchArena::getClassSize(newCls) < minCount * sizeof(T))
+            ++newCls;
+        T* newPtr = static_cast<T*>(arena.acquire(newCls));
+        stats.acquire(ScratchArena::getClassSize(newCls));
+        if (ptr) {
+            std::copy(ptr, ptr + count, newPtr);
+            release();
+        }
+        ptr = newPtr;
+        cls = newCls;
+        capacity = ScratchArena::getClassSize(cls) / sizeof(T);
+    }
+
+    void release() {
+        arena.release(cls, ptr);
+        stats.release(ScratchArena::getClassSize(cls));
+    }
+
+    ScratchStats& stats;
+    ScratchArena& arena;
+    size_t cls = 0;
+    size_t count = 0;
+    size_t capacity = 0;
+    T* ptr = nullptr;
+};
+
+}  // namespace TemplateExtension
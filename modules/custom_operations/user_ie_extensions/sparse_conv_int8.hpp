@@ -0,0 +1,227 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define SPARSE_CONV_INT8_X86
+#    include <immintrin.h>
+#endif
+
+#include "scratch_arena.hpp"
+
+// Int8 matrix multiplication of gathered features by kernel slices of quantized sparse convolutions.
+// Features are u8 (i8 features are shifted by 128 while they are gathered) and weights are i8, products
+// are accumulated in int32. The layout follows VNNI dot product instructions which multiply groups of
+// 4 u8 values by 4 i8 values and add their sum to an int32 lane.
+
+namespace TemplateExtension {
+
+// Input channels multiplied by a single dot product instruction
+const size_t int8ChannelsGroup = 4;
+// Output channels are padded to a multiple of the widest vector of int32 accumulators
+const size_t int8OutChannelsBlock = 16;
+
+inline size_t roundUpToMultiple(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// i8 kernel DxHxWxICxOC repacked to [offset][IC / 4][OC][4] with zero padding of input and output channels.
+// Every group of 4 input channels of an output channel is a contiguous int32 lane. Repacked weights are
+// scratch buffers of the thread which repacks them.
+struct Int8SparseConvWeights {
+    Int8SparseConvWeights(const int8_t* data, size_t numOffsets, size_t IC, size_t OC, ScratchStats& stats)
+        : ICp(roundUpToMultiple(IC, int8ChannelsGroup)),
+          OCp(roundUpToMultiple(OC, int8OutChannelsBlock)),
+          weights(stats, numOffsets * ICp * OCp),
+          columnSums(stats, numOffsets * OCp) {
+        std::fill_n(weights.data(), weights.size(), 0);
+        std::fill_n(columnSums.data(), columnSums.size(), 0);
+        for (size_t k = 0; k < numOffsets; ++k) {
+            const int8_t* src = data + k * IC * OC;
+            int8_t* dst = weights.data() + k * ICp * OCp;
+            int32_t* sums = columnSums.data() + k * OCp;
+            for (size_t ic = 0; ic < IC; ++ic) {
+                for (size_t oc = 0; oc < OC; ++oc) {
+                    const int8_t w = src[ic * OC + oc];
+                    dst[(ic / int8ChannelsGroup * OCp + oc) * int8ChannelsGroup + ic % int8ChannelsGroup] = w;
+                    sums[oc] += w;
+                }
+            }
+        }
+    }
+
+    const int8_t* offsetWeights(size_t k) const {
+        return weights.data() + k * ICp * OCp;
+    }
+
+    // Sums of weights of every output channel. Shift of i8 features by 128 adds 128 * sum to the results.
+    const int32_t* offsetColumnSums(size_t k) const {
+        return columnSums.data() + k * OCp;
+    }
+
+    size_t ICp, OCp;
+    ScratchBuffer<int8_t> weights;
+    ScratchBuffer<int32_t> columnSums;
+};
+
+// c[rows x OCp] = a[rows x ICp] * b[ICp x OCp] for u8 a and packed i8 b
+using Int8GemmKernel = void (*)(const uint8_t* a, const int8_t* b, int32_t* c, size_t rows, size_t ICp,
+                                size_t OCp);
+
+inline void int8GemmRef(const uint8_t* a, const int8_t* b, int32_t* c, size_t rows, size_t ICp, size_t OCp) {
+    std::fill_n(c, rows * OCp, 0);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t g = 0; g < ICp / int8ChannelsGroup; ++g) {
+            const uint8_t* ag = a + r * ICp + g * int8ChannelsGroup;
+            const int8_t* bg = b + g * OCp * int8ChannelsGroup;
+            for (size_t oc = 0; oc < OCp; ++oc) {
+                int32_t sum = 0;
+                for (size_t t = 0; t < int8ChannelsGroup; ++t)
+                    sum += ag[t] * bg[oc * int8ChannelsGroup + t];
+                c[r * OCp + oc] += sum;
+            }
+        }
+    }
+}
+
+#ifdef SPARSE_CONV_INT8_X86
+inline int32_t loadGroup(const uint8_t* a) {
+    int32_t group;
+    std::memcpy(&group, a, sizeof(group));
+    return group;
+}
+
+// Without VNNI the groups are widened to int16 and multiplied by madd, which sums pairs of products.
+// Pair sums of 4 output channels interleaved with pair sums of the next 4 are reduced by hadd at the end,
+// which leaves 64-bit halves of the result permuted within 128-bit lanes.
+__attribute__((target("avx2"))) inline void int8GemmAVX2(const uint8_t* a, const int8_t* b, int32_t* c,
+                                                        size_t rows, size_t ICp, size_t OCp) {
+    const size_t groups = ICp / int8ChannelsGroup;
+    for (size_t r = 0; r < rows; ++r) {
+        const uint8_t* ar = a + r * ICp;
+        for (size_t oc = 0; oc < OCp; oc += 8) {
+            __m256i lo = _mm256_setzero_si256();
+            __m256i hi = _mm256_setzero_si256();
+            for (size_t g = 0; g < groups; ++g) {
+                const __m256i va = _mm256_cvtepu8_epi16(_mm_set1_epi32(loadGroup(ar + g * int8ChannelsGroup)));
+                const int8_t* bg = b + (g * OCp + oc) * int8ChannelsGroup;
+                const __m128i* bv = reinterpret_cast<const __m128i*>(bg);
+                const __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(bv));
+                const __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(bv + 1));
+                lo = _mm256_add_epi32(lo, _mm256_madd_epi16(va, b0));
+                hi = _mm256_add_epi32(hi, _mm256_madd_epi16(va, b1));
+            }
+            const __m256i sums = _mm256_permute4x64_epi64(_mm256_hadd_epi32(lo, hi), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + r * OCp + oc), sums);
+        }
+    }
+}
+
+// Blocks of 4 rows share loaded weights. Every dpbusd adds 16 dot products of 4 channels.
+__attribute__((target("avx512f,avx512vnni"))) inline void int8GemmVNNI(const uint8_t* a, const int8_t* b,
+                                                                      int32_t* c, size_t rows, size_t ICp,
+                                                                      size_t OCp) {
+    const size_t groups = ICp / int8ChannelsGroup;
+    size_t r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        const uint8_t* ar = a + r * ICp;
+        for (size_t oc = 0; oc < OCp; oc += 16) {
+            __m512i c0 = _mm512_setzero_si512();
+            __m512i c1 = _mm512_setzero_si512();
+            __m512i c2 = _mm512_setzero_si512();
+            __m512i c3 = _mm512_setzero_si512();
+            for (size_t g = 0; g < groups; ++g) {
+                const __m512i vb = _mm512_loadu_si512(b + (g * OCp + oc) * int8ChannelsGroup);
+                const uint8_t* ag = ar + g * int8ChannelsGroup;
+                c0 = _mm512_dpbusd_epi32(c0, _mm512_set1_epi32(loadGroup(ag)), vb);
+                c1 = _mm512_dpbusd_epi32(c1, _mm512_set1_epi32(loadGroup(ag + ICp)), vb);
+                c2 = _mm512_dpbusd_epi32(c2, _mm512_set1_epi32(loadGroup(ag + 2 * ICp)), vb);
+                c3 = _mm512_dpbusd_epi32(c3, _mm512_set1_epi32(loadGroup(ag + 3 * ICp)), vb);
+            }
+            _mm512_storeu_si512(c + r * OCp + oc, c0);
+            _mm512_storeu_si512(c + (r + 1) * OCp + oc, c1);
+            _mm512_storeu_si512(c + (r + 2) * OCp + oc, c2);
+            _mm512_storeu_si512(c + (r + 3) * OCp + oc, c3);
+        }
+    }
+    for (; r < rows; ++r) {
+        const uint8_t* ar = a + r * ICp;
+        for (size_t oc = 0; oc < OCp; oc += 16) {
+            __m512i acc = _mm512_setzero_si512();
+            for (size_t g = 0; g < groups; ++g) {
+                const __m512i vb = _mm512_loadu_si512(b + (g * OCp + oc) * int8ChannelsGroup);
+                acc = _mm512_dpbusd_epi32(acc, _mm512_set1_epi32(loadGroup(ar + g * int8ChannelsGroup)), vb);
+            }
+            _mm512_storeu_si512(c + r * OCp + oc, acc);
+        }
+    }
+}
+#endif
+
+// Kernel is selected once for the instruction set of the host CPU
+inline Int8GemmKernel getInt8GemmKernel() {
+    static const Int8GemmKernel kernel = []() -> Int8GemmKernel {
+#ifdef SPARSE_CONV_INT8_X86
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vnni"))
+            return int8GemmVNNI;
+        if (__builtin_cpu_supports("avx2"))
+            return int8GemmAVX2;
+#endif
+        return int8GemmRef;
+    }();
+    return kernel;
+}
+
+// Gathers a row of features as u8 padded by zeros to ICp channels
+inline void gatherInt8Row(const uint8_t* features, size_t IC, size_t ICp, uint8_t* dst) {
+    std::copy_n(features, IC, dst);
+    std::fill(dst + IC, dst + ICp, 0);
+}
+
+inline void gatherInt8Row(const int8_t* features, size_t IC, size_t ICp, uint8_t* dst) {
+    for (size_t ic = 0; ic < IC; ++ic)
+        dst[ic] = static_cast<uint8_t>(features[ic]) ^ 0x80;
+    // Padded channels have zero weights, so their values do not matter
+    std::fill(dst + IC, dst + ICp, 0);
+}
+
+// Int8 counterpart of gatherGemmScatter(). out is an int32 buffer of OCp channels with rows starting at outBegin.
+// gathered and accum are scratch buffers of sparseConvPairsBlock * ICp and sparseConvPairsBlock * OCp elements.
+template <typename T>
+void gatherGemmScatterInt8(const T* features, const Int8SparseConvWeights& weights, size_t k, const size_t* inIdx,
+                           const size_t* outIdx, size_t numPairs, size_t IC, size_t pairsBlock, size_t outBegin,
+                           uint8_t* gathered, int32_t* accum, int32_t* out) {
+    const size_t ICp = weights.ICp;
+    const size_t OCp = weights.OCp;
+    const bool shifted = std::is_same<T, int8_t>::value;
+    const int32_t* columnSums = weights.offsetColumnSums(k);
+    const Int8GemmKernel gemm = getInt8GemmKernel();
+
+    for (size_t begin = 0; begin < numPairs; begin += pairsBlock) {
+        const size_t rows = std::min(pairsBlock, numPairs - begin);
+        for (size_t r = 0; r < rows; ++r)
+            gatherInt8Row(features + inIdx[begin + r] * IC, IC, ICp, gathered + r * ICp);
+        gemm(gathered, weights.offsetWeights(k), accum, rows, ICp, OCp);
+
+        for (size_t r = 0; r < rows; ++r) {
+            int32_t* dst = out + (outIdx[begin + r] - outBegin) * OCp;
+            const int32_t* src = accum + r * OCp;
+            if (shifted) {
+                for (size_t oc = 0; oc < OCp; ++oc)
+                    dst[oc] += src[oc] - 128 * columnSums[oc];
+            } else {
+                for (size_t oc = 0; oc < OCp; ++oc)
+                    dst[oc] += src[oc];
+            }
+        }
+    }
+}
+
+}  // namespace TemplateExtension
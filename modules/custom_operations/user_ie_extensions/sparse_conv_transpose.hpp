@@ -8,6 +8,10 @@
 
 namespace TemplateExtension {
 
+// Inputs: features [N, IC], input positions [N, 3], output positions [M, 3], kernel [D, H, W, IC, OC], offset [3]
+// and optional row splits of input and output points [B + 1] for a batch of B clouds. Without row splits
+// input positions are terminated by a negative coordinate. A quantized convolution has u8 or i8 features,
+// an i8 kernel and f32 scales of output channels [OC] or [1] as the last input, its output is f32.
 class SparseConvTranspose : public ov::op::Op {
 public:
     OPENVINO_OP("SparseConvTranspose");
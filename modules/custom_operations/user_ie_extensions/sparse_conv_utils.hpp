@@ -0,0 +1,573 @@
+// Copyright (C) 2018-2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <openvino/core/parallel.hpp>
+
+#include "op_profile.hpp"
+#include "op_threads.hpp"
+#include "row_splits.hpp"
+#include "scratch_arena.hpp"
+#include "sparse_conv_int8.hpp"
+
+namespace TemplateExtension {
+
+// Hash grid which buckets points into voxels of the kernel window size. A window query
+// touches at most 2x2x2 voxels instead of scanning the whole cloud. Points of a batch of clouds
+// are split by splits, and voxels of different clouds are different. The voxel table and
+// point indices are scratch buffers of the thread which builds the grid.
+class VoxelHashGrid {
+public:
+    VoxelHashGrid(const float* pos, const size_t* splits, size_t numClouds, float cellW, float cellH, float cellD,
+                  ScratchStats& stats)
+        : pos(pos),
+          invCellW(1.0f / cellW),
+          invCellH(1.0f / cellH),
+          invCellD(1.0f / cellD),
+          cells(stats, getTableSize(splits[numClouds])),
+          indices(stats, splits[numClouds]) {
+        const size_t numPoints = splits[numClouds];
+        for (size_t c = 0; c < cells.size(); ++c)
+            cells[c].end = 0;
+
+        // Every voxel counts its points in the end field first
+        ScratchBuffer<size_t> pointCell(stats, numPoints);
+        for (size_t cloud = 0; cloud < numClouds; ++cloud) {
+            for (size_t j = splits[cloud]; j < splits[cloud + 1]; ++j) {
+                const VoxelKey key = getKey(cloud, pos[j * 3], pos[j * 3 + 1], pos[j * 3 + 2]);
+                size_t c = findSlot(key);
+                if (cells[c].end == 0)
+                    cells[c].key = key;
+                cells[c].end += 1;
+                pointCell[j] = c;
+            }
+        }
+
+        // Prefix sums give every voxel a contiguous range of point indices
+        size_t start = 0;
+        for (size_t c = 0; c < cells.size(); ++c) {
+            const size_t count = cells[c].end;
+            if (count == 0)
+                continue;
+            cells[c].begin = start;
+            cells[c].end = start;
+            start += count;
+        }
+
+        // Points are visited in ascending order so indices inside every voxel stay sorted.
+        for (size_t j = 0; j < numPoints; ++j)
+            indices[cells[pointCell[j]].end++] = j;
+    }
+
+    // Calls func(j) for every point j of a cloud inside the box [x - rw, x + rw] x [y - rh, y + rh] x
+    // [z - rd, z + rd] in ascending order of j. That keeps the same order of accumulation as a plain scan
+    // over all the points.
+    // candidates is a caller-owned scratch buffer to avoid allocations per query.
+    template <typename F>
+    void forEachNeighbor(size_t cloud, float x, float y, float z, float rw, float rh, float rd,
+                         ScratchVector<size_t>& candidates, const F& func) const {
+        candidates.clear();
+        const VoxelKey lo = getKey(cloud, x - rw, y - rh, z - rd);
+        const VoxelKey hi = getKey(cloud, x + rw, y + rh, z + rd);
+        size_t numCells = 0;
+        for (int64_t cz = lo.z; cz <= hi.z; ++cz) {
+            for (int64_t cy = lo.y; cy <= hi.y; ++cy) {
+                for (int64_t cx = lo.x; cx <= hi.x; ++cx) {
+                    const Cell& cell = cells[findSlot(VoxelKey{cx, cy, cz, cloud})];
+                    if (cell.end == 0)
+                        continue;
+                    candidates.append(indices.data() + cell.begin, indices.data() + cell.end);
+                    numCells += 1;
+                }
+            }
+        }
+        if (numCells > 1)
+            std::sort(candidates.begin(), candidates.end());
+
+        for (size_t j : candidates) {
+            const float xj = pos[j * 3];
+            const float yj = pos[j * 3 + 1];
+            const float zj = pos[j * 3 + 2];
+            if (x - rw <= xj && xj <= x + rw &&
+                y - rh <= yj && yj <= y + rh &&
+                z - rd <= zj && zj <= z + rd) {
+                func(j);
+            }
+        }
+    }
+
+private:
+    struct VoxelKey {
+        int64_t x, y, z;
+        size_t cloud;
+        bool operator==(const VoxelKey& other) const {
+            return x == other.x && y == other.y && z == other.z && cloud == other.cloud;
+        }
+    };
+
+    // Slot of the open addressing table. Every voxel has at least one point, so empty slots have end == 0.
+    struct Cell {
+        VoxelKey key;
+        size_t begin, end;
+    };
+
+    static size_t getHash(const VoxelKey& key) {
+        uint64_t h = static_cast<uint64_t>(key.x) * 73856093ull;
+        h ^= static_cast<uint64_t>(key.y) * 19349663ull;
+        h ^= static_cast<uint64_t>(key.z) * 83492791ull;
+        h ^= static_cast<uint64_t>(key.cloud) * 50331653ull;
+        return static_cast<size_t>(h);
+    }
+
+    // Power of two which keeps the table at most half full
+    static size_t getTableSize(size_t numPoints) {
+        size_t size = 16;
+        while (size < 2 * numPoints)
+            size *= 2;
+        return size;
+    }
+
+    // Slot of a voxel or the empty slot where the voxel would be inserted. Linear probing always
+    // stops because the table has empty slots.
+    size_t findSlot(const VoxelKey& key) const {
+        const size_t mask = cells.size() - 1;
+        size_t c = getHash(key) & mask;
+        while (cells[c].end != 0 && !(cells[c].key == key))
+            c = (c + 1) & mask;
+        return c;
+    }
+
+    // Voxel index of a scaled coordinate. Large and infinite coordinates are clamped to keep the cast defined
+    // and voxel loops free of overflows. NaN goes to the lowest voxel, but it never passes the box check.
+    static int64_t getCell(float coord) {
+        const int64_t maxCell = int64_t(1) << 62;
+        const float cell = std::floor(coord);
+        if (cell >= static_cast<float>(maxCell))
+            return maxCell;
+        if (!(cell > -static_cast<float>(maxCell)))
+            return -maxCell;
+        return static_cast<int64_t>(cell);
+    }
+
+    // Scaling, floor and clamping are monotonic so every point inside a query box falls into
+    // a voxel between the voxels of the box corners.
+    VoxelKey getKey(size_t cloud, float x, float y, float z) const {
+        return VoxelKey{getCell(x * invCellW), getCell(y * invCellH), getCell(z * invCellD), cloud};
+    }
+
+    const float* pos;
+    float invCellW, invCellH, invCellD;
+    ScratchBuffer<Cell> cells;
+    ScratchBuffer<size_t> indices;
+};
+
+// Kernel layout is DxHxWxICxOC
+struct SparseConvKernel {
+    SparseConvKernel(const float* data, const std::vector<size_t>& dims)
+        : data(data),
+          kd(static_cast<int>(dims[0])),
+          kh(static_cast<int>(dims[1])),
+          kw(static_cast<int>(dims[2])),
+          IC(static_cast<int>(dims[3])),
+          OC(static_cast<int>(dims[4])),
+          // See https://github.com/isl-org/Open3D/blob/master/python/open3d/ml/torch/python/layers/convolutions.py
+          rw(kw * 0.51f),
+          rh(kh * 0.51f),
+          rd(kd * 0.51f) {}
+
+    size_t numOffsets() const {
+        return static_cast<size_t>(kd) * kh * kw;
+    }
+
+    const float* data;
+    int kd, kh, kw, IC, OC;
+    // Half sizes of the kernel window
+    float rw, rh, rd;
+};
+
+// Calls func(i, j, k) for every pair of output point i from [outBegin, outEnd) and input point j of the same cloud
+// inside its kernel window, where k is a linear kernel offset w + kw * (h + kh * d). Clouds of output points are
+// split by outSplits. Pairs are visited in ascending order of i and then j.
+// Transposed convolution uses the same neighbors but spatially flipped kernel.
+template <typename F>
+void forEachKernelPair(const VoxelHashGrid& grid, const float* inpPos, const float* outPos, const size_t* outSplits,
+                       const float* offset, size_t outBegin, size_t outEnd, const SparseConvKernel& kernel,
+                       bool transposed, ScratchStats& scratchStats, const F& func) {
+    const int kd = kernel.kd;
+    const int kh = kernel.kh;
+    const int kw = kernel.kw;
+    const float rw = kernel.rw;
+    const float rh = kernel.rh;
+    const float rd = kernel.rd;
+
+    ScratchVector<size_t> candidates(scratchStats);
+    size_t cloud = 0;
+    for (size_t i = outBegin; i < outEnd; ++i) {
+        while (i >= outSplits[cloud + 1])
+            ++cloud;
+        const float xi = outPos[i * 3] - offset[0];
+        const float yi = outPos[i * 3 + 1] - offset[1];
+        const float zi = outPos[i * 3 + 2] - offset[2];
+
+        grid.forEachNeighbor(cloud, xi, yi, zi, rw, rh, rd, candidates, [&](size_t j) {
+            const float xj = inpPos[j * 3];
+            const float yj = inpPos[j * 3 + 1];
+            const float zj = inpPos[j * 3 + 2];
+
+            int w = std::min(static_cast<int>(xj - xi + kw * 0.5f), kw - 1);
+            int h = std::min(static_cast<int>(yj - yi + kh * 0.5f), kh - 1);
+            int d = std::min(static_cast<int>(zj - zi + kd * 0.5f), kd - 1);
+            if (transposed) {
+                w = kw - 1 - w;
+                h = kh - 1 - h;
+                d = kd - 1 - d;
+            }
+            func(i, j, w + kw * (h + kh * d));
+        });
+    }
+}
+
+// Output point i, input point j and kernel offset k of a pair visited by forEachKernelPair()
+struct SparseConvPair {
+    size_t i, j, k;
+};
+
+// Lists of (input, output) point pairs for every kernel offset. Pairs of the same offset share
+// one ICxOC slice of weights so they are processed by a single matrix multiplication.
+// Pairs of offset k take the range [starts[k], starts[k + 1]) of inIdx and outIdx.
+struct SparseConvRulebook {
+    SparseConvRulebook(const ScratchVector<SparseConvPair>& pairs, size_t numOffsets, ScratchStats& stats)
+        : inIdx(stats, pairs.size()),
+          outIdx(stats, pairs.size()),
+          starts(stats, numOffsets + 1) {
+        std::fill_n(starts.data(), numOffsets + 1, 0);
+        for (const SparseConvPair& pair : pairs)
+            starts[pair.k + 1] += 1;
+        for (size_t k = 0; k < numOffsets; ++k)
+            starts[k + 1] += starts[k];
+
+        // Counting sort by offsets keeps pairs of every offset in the order of visiting
+        ScratchBuffer<size_t> cursors(stats, numOffsets);
+        std::copy_n(starts.data(), numOffsets, cursors.data());
+        for (const SparseConvPair& pair : pairs) {
+            const size_t idx = cursors[pair.k]++;
+            inIdx[idx] = pair.j;
+            outIdx[idx] = pair.i;
+        }
+    }
+
+    ScratchBuffer<size_t> inIdx;
+    ScratchBuffer<size_t> outIdx;
+    ScratchBuffer<size_t> starts;
+};
+
+// Number of rows gathered at once by gatherGemmScatter(). Keeps both A and C blocks in L1/L2 cache.
+static const size_t sparseConvPairsBlock = 64;
+
+// Computes out[MxOC] += A[MxIC] * B[ICxOC] where rows of A are features gathered by inIdx
+// and rows of the result are scattered to outIdx. gathered and accum are scratch buffers of
+// sparseConvPairsBlock * IC and sparseConvPairsBlock * OC elements.
+inline void gatherGemmScatter(const float* features, const float* weights, const size_t* inIdx,
+                              const size_t* outIdx, size_t numPairs, int IC, int OC, float* gathered,
+                              float* accum, float* out) {
+    // Number of rows which share loaded weights
+    static const size_t rowsBlock = 4;
+    const size_t pairsBlock = sparseConvPairsBlock;
+
+    for (size_t begin = 0; begin < numPairs; begin += pairsBlock) {
+        const size_t rows = std::min(pairsBlock, numPairs - begin);
+        for (size_t r = 0; r < rows; ++r)
+            std::copy_n(features + inIdx[begin + r] * IC, IC, gathered + r * IC);
+        std::fill_n(accum, rows * OC, 0.0f);
+
+        size_t r = 0;
+        for (; r + rowsBlock <= rows; r += rowsBlock) {
+            const float* a = gathered + r * IC;
+            float* c0 = accum + r * OC;
+            float* c1 = c0 + OC;
+            float* c2 = c1 + OC;
+            float* c3 = c2 + OC;
+            for (int ic = 0; ic < IC; ++ic) {
+                const float a0 = a[ic];
+                const float a1 = a[IC + ic];
+                const float a2 = a[2 * IC + ic];
+                const float a3 = a[3 * IC + ic];
+                const float* b = weights + ic * OC;
+                for (int oc = 0; oc < OC; ++oc) {
+                    c0[oc] += a0 * b[oc];
+                    c1[oc] += a1 * b[oc];
+                    c2[oc] += a2 * b[oc];
+                    c3[oc] += a3 * b[oc];
+                }
+            }
+        }
+        for (; r < rows; ++r) {
+            const float* a = gathered + r * IC;
+            float* c = accum + r * OC;
+            for (int ic = 0; ic < IC; ++ic) {
+                const float* b = weights + ic * OC;
+                for (int oc = 0; oc < OC; ++oc)
+                    c[oc] += a[ic] * b[oc];
+            }
+        }
+
+        for (size_t r = 0; r < rows; ++r) {
+            float* dst = out + outIdx[begin + r] * OC;
+            const float* src = accum + r * OC;
+            for (int oc = 0; oc < OC; ++oc)
+                dst[oc] += src[oc];
+        }
+    }
+}
+
+// Channels number starting from which dense matrix multiplications per kernel offset
+// outperform accumulation of every pair of points separately.
+static const int sparseConvGemmMinChannels = 16;
+
+// Minimal number of output points processed by a single thread
+static const size_t sparseConvOutPointsPerThread = 64;
+
+// Profiled phases of SparseConv and SparseConvTranspose. Neighbor search and GEMM are measured by every thread.
+struct SparseConvProfile {
+    explicit SparseConvProfile(const std::string& opType)
+        : total(getProfilePhase(opType, "total")),
+          grid(getProfilePhase(opType, "grid")),
+          neighborSearch(getProfilePhase(opType, "neighbor_search")),
+          gemm(getProfilePhase(opType, "gemm")),
+          direct(getProfilePhase(opType, "direct")) {}
+
+    ProfilePhase& total;
+    // Hash grid of input points
+    ProfilePhase& grid;
+    // Rulebooks of pairs of input and output points
+    ProfilePhase& neighborSearch;
+    // Gather-GEMM-scatter of rulebooks, including dequantization of int8 results
+    ProfilePhase& gemm;
+    // Accumulation of every pair while neighbors are searched, for a small number of channels
+    ProfilePhase& direct;
+};
+
+// Builds a grid of input points. All the clouds share the grid whose voxels belong to separate clouds.
+inline std::unique_ptr<const VoxelHashGrid> buildSparseConvGrid(const float* inpPos, const size_t* inpSplits,
+                                                                size_t numClouds, const SparseConvKernel& kernel,
+                                                                ScratchStats& scratchStats, ProfilePhase& phase) {
+    ProfileScope scope(phase);
+    return std::unique_ptr<const VoxelHashGrid>(new VoxelHashGrid(inpPos, inpSplits, numClouds, 2 * kernel.rw,
+                                                                  2 * kernel.rh, 2 * kernel.rd, scratchStats));
+}
+
+// Builds a rulebook of output points [outBegin, outEnd). pairs is a scratch vector of the calling thread.
+inline std::unique_ptr<const SparseConvRulebook> buildSparseConvRulebook(
+    const VoxelHashGrid& grid, const float* inpPos, const float* outPos, const size_t* outSplits, const float* offset,
+    size_t outBegin, size_t outEnd, const SparseConvKernel& kernel, bool transposed, ScratchStats& scratchStats,
+    ScratchVector<SparseConvPair>& pairs, ProfilePhase& phase) {
+    ProfileScope scope(phase);
+    forEachKernelPair(grid, inpPos, outPos, outSplits, offset, outBegin, outEnd, kernel, transposed, scratchStats,
+                      [&](size_t i, size_t j, int k) {
+        pairs.push_back(SparseConvPair{i, j, static_cast<size_t>(k)});
+    });
+    return std::unique_ptr<const SparseConvRulebook>(new SparseConvRulebook(pairs, kernel.numOffsets(), scratchStats));
+}
+
+inline int getSparseConvThreads(size_t numOutPoints, const OpThreads& threads) {
+    const size_t maxThreads = (numOutPoints + sparseConvOutPointsPerThread - 1) / sparseConvOutPointsPerThread;
+    return static_cast<int>(std::max<size_t>(
+        1, std::min<size_t>(maxThreads, static_cast<size_t>(threads.getMaxThreads()))));
+}
+
+// Shared implementation of SparseConv and SparseConvTranspose. out must be zero initialized.
+// Points of a batch of clouds are split by inpSplits and outSplits: output points of cloud c are computed only
+// from input points of the same cloud.
+//
+// Output points are split into contiguous ranges, one per thread. Every thread finds neighbors and accumulates
+// results only for its own output rows, so there are no concurrent writes and the order of accumulation for each
+// output row does not depend on the number of threads. Scatter-based rulebook processing follows the same rule:
+// every thread builds a rulebook of its output range and scatters into the rows it owns.
+inline void sparseConvolution(const float* features, const float* inpPos, const size_t* inpSplits,
+                              const float* outPos, const size_t* outSplits, size_t numClouds,
+                              const SparseConvKernel& kernel, const float* offset, bool transposed, float* out,
+                              ScratchStats& scratchStats, const OpThreads& threads,
+                              const SparseConvProfile& profile) {
+    const int IC = kernel.IC;
+    const int OC = kernel.OC;
+    const bool useGemm = IC >= sparseConvGemmMinChannels && OC >= sparseConvGemmMinChannels;
+    const size_t numOutPoints = outSplits[numClouds];
+    const std::unique_ptr<const VoxelHashGrid> grid =
+        buildSparseConvGrid(inpPos, inpSplits, numClouds, kernel, scratchStats, profile.grid);
+
+    ov::parallel_nt(getSparseConvThreads(numOutPoints, threads), [&](const int ithr, const int nthr) {
+        size_t outBegin = 0, outEnd = 0;
+        ov::splitter(numOutPoints, nthr, ithr, outBegin, outEnd);
+        if (outBegin >= outEnd)
+            return;
+
+        if (!useGemm) {
+            ProfileScope scope(profile.direct);
+            // Accumulate features which inside the kernel
+            forEachKernelPair(*grid, inpPos, outPos, outSplits, offset, outBegin, outEnd, kernel, transposed,
+                              scratchStats, [&](size_t i, size_t j, int k) {
+                const float* featuresOffset = features + j * IC;
+                for (int ic = 0; ic < IC; ++ic) {
+                    const float* kernelOffset = kernel.data + OC * (ic + IC * k);
+                    for (int oc = 0; oc < OC; ++oc) {
+                        out[i * OC + oc] += kernelOffset[oc] * featuresOffset[ic];
+                    }
+                }
+            });
+            return;
+        }
+
+        // Build a rulebook and then run gather-GEMM-scatter for every kernel offset
+        ScratchVector<SparseConvPair> pairs(scratchStats);
+        const std::unique_ptr<const SparseConvRulebook> rulebook =
+            buildSparseConvRulebook(*grid, inpPos, outPos, outSplits, offset, outBegin, outEnd, kernel, transposed,
+                                    scratchStats, pairs, profile.neighborSearch);
+        ProfileScope scope(profile.gemm);
+
+        ScratchBuffer<float> gathered(scratchStats, sparseConvPairsBlock * IC);
+        ScratchBuffer<float> accum(scratchStats, sparseConvPairsBlock * OC);
+        for (size_t k = 0; k < kernel.numOffsets(); ++k) {
+            const size_t begin = rulebook->starts[k];
+            gatherGemmScatter(features, kernel.data + k * IC * OC, rulebook->inIdx.data() + begin,
+                              rulebook->outIdx.data() + begin, rulebook->starts[k + 1] - begin, IC, OC,
+                              gathered.data(), accum.data(), out);
+        }
+    });
+}
+
+// Quantized convolution of u8 or i8 features by an i8 kernel. Products are accumulated in int32 by
+// gather-GEMM-scatter for any number of channels and out[i, oc] = scales[oc] * sum. scales combine scales of
+// features and weights, a single scale is shared by all the output channels. Zero points are not supported.
+// Work is split between threads as in sparseConvolution().
+template <typename T>
+void sparseConvolutionInt8(const T* features, const float* inpPos, const size_t* inpSplits, const float* outPos,
+                           const size_t* outSplits, size_t numClouds, const SparseConvKernel& kernel,
+                           const int8_t* kernelData, const float* scales, size_t numScales, const float* offset,
+                           bool transposed, float* out, ScratchStats& scratchStats, const OpThreads& threads,
+                           const SparseConvProfile& profile) {
+    const size_t IC = kernel.IC;
+    const size_t OC = kernel.OC;
+    const size_t numOutPoints = outSplits[numClouds];
+    const std::unique_ptr<const VoxelHashGrid> grid =
+        buildSparseConvGrid(inpPos, inpSplits, numClouds, kernel, scratchStats, profile.grid);
+    const Int8SparseConvWeights weights(kernelData, kernel.numOffsets(), IC, OC, scratchStats);
+    const size_t OCp = weights.OCp;
+
+    ov::parallel_nt(getSparseConvThreads(numOutPoints, threads), [&](const int ithr, const int nthr) {
+        size_t outBegin = 0, outEnd = 0;
+        ov::splitter(numOutPoints, nthr, ithr, outBegin, outEnd);
+        if (outBegin >= outEnd)
+            return;
+
+        ScratchVector<SparseConvPair> pairs(scratchStats);
+        const std::unique_ptr<const SparseConvRulebook> rulebook =
+            buildSparseConvRulebook(*grid, inpPos, outPos, outSplits, offset, outBegin, outEnd, kernel, transposed,
+                                    scratchStats, pairs, profile.neighborSearch);
+        ProfileScope scope(profile.gemm);
+
+        // Sums of the rows owned by the thread
+        ScratchBuffer<int32_t> sums(scratchStats, (outEnd - outBegin) * OCp);
+        std::fill_n(sums.data(), sums.size(), 0);
+        ScratchBuffer<uint8_t> gathered(scratchStats, sparseConvPairsBlock * weights.ICp);
+        ScratchBuffer<int32_t> accum(scratchStats, sparseConvPairsBlock * OCp);
+        for (size_t k = 0; k < kernel.numOffsets(); ++k) {
+            const size_t begin = rulebook->starts[k];
+            gatherGemmScatterInt8(features, weights, k, rulebook->inIdx.data() + begin, rulebook->outIdx.data() + begin,
+                                  rulebook->starts[k + 1] - begin, IC, sparseConvPairsBlock, outBegin,
+                                  gathered.data(), accum.data(), sums.data());
+        }
+
+        for (size_t i = outBegin; i < outEnd; ++i) {
+            const int32_t* src = sums.data() + (i - outBegin) * OCp;
+            for (size_t oc = 0; oc < OC; ++oc)
+                out[i * OC + oc] = static_cast<float>(src[oc]) * scales[numScales == 1 ? 0 : oc];
+        }
+    });
+}
+
+// Quantized convolution has an i8 kernel, u8 or i8 features and scales of output channels as the last input
+inline bool isQuantizedSparseConv(const ov::element::Type& kernelType) {
+    return kernelType == ov::element::i8;
+}
+
+// Inputs are 5 or 7 with row splits and scales of a quantized convolution
+inline bool isSparseConvInputsNumber(size_t numInputs, bool quantized) {
+    const size_t numScales = quantized ? 1 : 0;
+    return numInputs == 5 + numScales || numInputs == 7 + numScales;
+}
+
+// Returns true if input i of a convolution with numInputs inputs can be evaluated
+inline bool isSparseConvInputType(size_t i, size_t numInputs, const ov::element::Type& type, bool quantized) {
+    if (quantized && i == 0)
+        return type == ov::element::u8 || type == ov::element::i8;
+    if (quantized && i == 3)
+        return type == ov::element::i8;
+    if (i < 5 || (quantized && i + 1 == numInputs))
+        return type == ov::element::f32;
+    return isRowSplitsType(type);
+}
+
+// Evaluates SparseConv or SparseConvTranspose. Inputs are features, input positions, output positions, kernel,
+// offset, optional row splits of input and output points and scales of output channels for an i8 kernel.
+// Without row splits the input is a single cloud which is terminated by a negative coordinate.
+inline void evaluateSparseConvolution(ov::TensorVector& outputs, const ov::TensorVector& inputs, bool transposed,
+                                      ScratchStats& scratchStats, const OpThreads& threads,
+                                      const SparseConvProfile& profile) {
+    const bool quantized = isQuantizedSparseConv(inputs[3].get_element_type());
+    const float* inpPos = inputs[1].data<float>();
+    const float* outPos = inputs[2].data<float>();
+    const float* offset = inputs[4].data<float>();
+    float* out = outputs[0].data<float>();
+    memset(out, 0, outputs[0].get_byte_size());
+
+    const size_t numInpPoints = inputs[1].get_shape()[0];
+    const size_t numOutPoints = inputs[2].get_shape()[0];
+    const bool hasSplits = inputs.size() > (quantized ? 6 : 5);
+    const size_t numClouds = hasSplits ? getNumClouds(inputs[5]) : 1;
+    ScratchBuffer<size_t> inpSplits(scratchStats, numClouds + 1);
+    ScratchBuffer<size_t> outSplits(scratchStats, numClouds + 1);
+    if (hasSplits) {
+        OPENVINO_ASSERT(getNumClouds(inputs[6]) == numClouds,
+                        "Row splits of input and output points must have the same number of clouds");
+        readRowSplits(inputs[5], numInpPoints, inpSplits.data());
+        readRowSplits(inputs[6], numOutPoints, outSplits.data());
+    } else {
+        inpSplits[0] = 0;
+        inpSplits[1] = countValidPoints(inpPos, numInpPoints);
+        outSplits[0] = 0;
+        outSplits[1] = numOutPoints;
+    }
+
+    if (!quantized) {
+        const SparseConvKernel kernelDesc(inputs[3].data<float>(), inputs[3].get_shape());
+        sparseConvolution(inputs[0].data<float>(), inpPos, inpSplits.data(), outPos, outSplits.data(), numClouds,
+                          kernelDesc, offset, transposed, out, scratchStats, threads, profile);
+        return;
+    }
+
+    const SparseConvKernel kernelDesc(nullptr, inputs[3].get_shape());
+    const ov::Tensor& scales = inputs.back();
+    OPENVINO_ASSERT(scales.get_size() == 1 || scales.get_size() == static_cast<size_t>(kernelDesc.OC),
+                    "Scales of a quantized sparse convolution must have one value or one value per output channel");
+    const int8_t* kernelData = inputs[3].data<int8_t>();
+    if (inputs[0].get_element_type() == ov::element::u8) {
+        sparseConvolutionInt8(inputs[0].data<uint8_t>(), inpPos, inpSplits.data(), outPos, outSplits.data(),
+                              numClouds, kernelDesc, kernelData, scales.data<float>(), scales.get_size(), offset,
+                              transposed, out, scratchStats, threads, profile);
+    } else {
+        sparseConvolutionInt8(inputs[0].data<int8_t>(), inpPos, inpSplits.data(), outPos, outSplits.data(),
+                              numClouds, kernelDesc, kernelData, scales.data<float>(), scales.get_size(), offset,
+                              transposed, out, scratchStats, threads, profile);
+    }
+}
+
+}  // namespace TemplateExtension